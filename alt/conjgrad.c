@@ -22,33 +22,18 @@
 #include <conjgrad.h>
 
 
-/* Array initialization. */
-static
-void init_array(int na,
-    DATA_TYPE POLYBENCH_1D(p,NA,na),
-    DATA_TYPE POLYBENCH_1D(q,NA,na),
-    DATA_TYPE POLYBENCH_1D(z,NA,na),
-    DATA_TYPE POLYBENCH_1D(r,NA,na))
-{
-    int j;
-
-    for (j = 0; j < na; j++) {
-        q[j] = 0.00001 *j;
-        z[j] = 0.00002 *j;
-        r[j] = 0.00003 *j;
-        p[j] = r[j];
-    }
-}
+/* Include array initialization, shared by all versions. */
+#include <conjgrad_init.h>
 
 
 /* DCE code. Must scan the entire live-out data.
    Can be used also to check the correctness of the output. */
 static
-void print_array(int na,
+void print_array(INDEX_TYPE na,
     DATA_TYPE POLYBENCH_1D(z,NA,na),
     DATA_TYPE POLYBENCH_1D(r,NA,na))
 {
-  int i;
+  INDEX_TYPE i;
   POLYBENCH_DUMP_START;
   POLYBENCH_DUMP_BEGIN("z");
   for (i = 0; i < na; i++) {
@@ -69,14 +54,14 @@ void print_array(int na,
 /* Main computational kernel. The whole function will be timed,
    including the call and return. */
 static
-void kernel_conjgrad(int na, int niter,
+void kernel_conjgrad(INDEX_TYPE na, INDEX_TYPE niter,
      DATA_TYPE POLYBENCH_1D(p,NA,na),
      DATA_TYPE POLYBENCH_1D(q,NA,na),
      DATA_TYPE POLYBENCH_1D(z,NA,na),
      DATA_TYPE POLYBENCH_1D(r,NA,na))
 {
-  int i;
-  int j;
+  INDEX_TYPE i;
+  INDEX_TYPE j;
 
   double rho;
   double d;
@@ -111,8 +96,8 @@ void kernel_conjgrad(int na, int niter,
 int main(int argc, char** argv)
 {
   /* Retrieve problem size. */
-  int na = NA;
-  int niter = NITER;
+  INDEX_TYPE na = NA;
+  INDEX_TYPE niter = NITER;
 
   /* Variable declaration/allocation. */
   POLYBENCH_1D_ARRAY_DECL(p,DATA_TYPE,NA,na);
@@ -121,11 +106,15 @@ int main(int argc, char** argv)
   POLYBENCH_1D_ARRAY_DECL(r,DATA_TYPE,NA,na);
 
   /* Initialize array(s). */
-  init_array (na,
+  polybench_cached_init (init_array (na,
               POLYBENCH_ARRAY(p),
               POLYBENCH_ARRAY(q),
               POLYBENCH_ARRAY(z),
-              POLYBENCH_ARRAY(r));
+              POLYBENCH_ARRAY(r)));
+
+  /* Work and memory traffic of the kernel, see the header. */
+  polybench_set_program_flops (POLYBENCH_PROGRAM_FLOPS);
+  polybench_set_program_bytes (POLYBENCH_PROGRAM_BYTES);
 
   /* Start timer. */
   polybench_start_instruments;
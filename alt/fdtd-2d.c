@@ -21,40 +21,20 @@
 #include <fdtd-2d.h>
 
 
-/* Array initialization. */
-static
-void init_array (int tmax,
-		 int nx,
-		 int ny,
-		 DATA_TYPE POLYBENCH_2D(ex,NX,NY,nx,ny),
-		 DATA_TYPE POLYBENCH_2D(ey,NX,NY,nx,ny),
-		 DATA_TYPE POLYBENCH_2D(hz,NX,NY,nx,ny),
-		 DATA_TYPE POLYBENCH_1D(_fict_,TMAX,tmax))
-{
-  int i, j;
-
-  for (i = 0; i < tmax; i++)
-    _fict_[i] = (DATA_TYPE) i;
-  for (i = 0; i < nx; i++)
-    for (j = 0; j < ny; j++)
-      {
-	ex[i][j] = ((DATA_TYPE) i*(j+1)) / nx;
-	ey[i][j] = ((DATA_TYPE) i*(j+2)) / ny;
-	hz[i][j] = ((DATA_TYPE) i*(j+3)) / nx;
-      }
-}
+/* Include array initialization, shared by all versions. */
+#include <fdtd-2d_init.h>
 
 
 /* DCE code. Must scan the entire live-out data.
    Can be used also to check the correctness of the output. */
 static
-void print_array(int nx,
-		 int ny,
+void print_array(INDEX_TYPE nx,
+		 INDEX_TYPE ny,
 		 DATA_TYPE POLYBENCH_2D(ex,NX,NY,nx,ny),
 		 DATA_TYPE POLYBENCH_2D(ey,NX,NY,nx,ny),
 		 DATA_TYPE POLYBENCH_2D(hz,NX,NY,nx,ny))
 {
-  int i, j;
+  INDEX_TYPE i, j;
 
   POLYBENCH_DUMP_START;
   POLYBENCH_DUMP_BEGIN("ex");
@@ -87,17 +67,17 @@ void print_array(int nx,
 /* Main computational kernel. The whole function will be timed,
    including the call and return. */
 static
-void kernel_fdtd_2d(int tmax,
-		    int nx,
-		    int ny,
+void kernel_fdtd_2d(INDEX_TYPE tmax,
+		    INDEX_TYPE nx,
+		    INDEX_TYPE ny,
 		    DATA_TYPE POLYBENCH_2D(ex,NX,NY,nx,ny),
 		    DATA_TYPE POLYBENCH_2D(ey,NX,NY,nx,ny),
 		    DATA_TYPE POLYBENCH_2D(hz,NX,NY,nx,ny),
 		    DATA_TYPE POLYBENCH_1D(_fict_,TMAX,tmax))
 {
-  int t;
-  int i;
-  int j;
+  INDEX_TYPE t;
+  INDEX_TYPE i;
+  INDEX_TYPE j;
   double _fict__buf0;
   for (t = 0; t <= -1 + tmax; t += 1) {
     _fict__buf0 = _fict_[t];
@@ -131,9 +111,9 @@ void kernel_fdtd_2d(int tmax,
 int main(int argc, char** argv)
 {
   /* Retrieve problem size. */
-  int tmax = TMAX;
-  int nx = NX;
-  int ny = NY;
+  INDEX_TYPE tmax = TMAX;
+  INDEX_TYPE nx = NX;
+  INDEX_TYPE ny = NY;
 
   /* Variable declaration/allocation. */
   POLYBENCH_2D_ARRAY_DECL(ex,DATA_TYPE,NX,NY,nx,ny);
@@ -142,11 +122,15 @@ int main(int argc, char** argv)
   POLYBENCH_1D_ARRAY_DECL(_fict_,DATA_TYPE,TMAX,tmax);
 
   /* Initialize array(s). */
-  init_array (tmax, nx, ny,
+  polybench_cached_init (init_array (tmax, nx, ny,
 	      POLYBENCH_ARRAY(ex),
 	      POLYBENCH_ARRAY(ey),
 	      POLYBENCH_ARRAY(hz),
-	      POLYBENCH_ARRAY(_fict_));
+	      POLYBENCH_ARRAY(_fict_)));
+
+  /* Work and memory traffic of the kernel, see the header. */
+  polybench_set_program_flops (POLYBENCH_PROGRAM_FLOPS);
+  polybench_set_program_bytes (POLYBENCH_PROGRAM_BYTES);
 
   /* Start timer. */
   polybench_start_instruments;
@@ -21,38 +21,19 @@
 #include <mvt.h>
 
 
-/* Array initialization. */
-static
-void init_array(int n,
-		DATA_TYPE POLYBENCH_1D(x1,N,n),
-		DATA_TYPE POLYBENCH_1D(x2,N,n),
-		DATA_TYPE POLYBENCH_1D(y_1,N,n),
-		DATA_TYPE POLYBENCH_1D(y_2,N,n),
-		DATA_TYPE POLYBENCH_2D(A,N,N,n,n))
-{
-  int i, j;
-
-  for (i = 0; i < n; i++)
-    {
-      x1[i] = (DATA_TYPE) (i % n) / n;
-      x2[i] = (DATA_TYPE) ((i + 1) % n) / n;
-      y_1[i] = (DATA_TYPE) ((i + 3) % n) / n;
-      y_2[i] = (DATA_TYPE) ((i + 4) % n) / n;
-      for (j = 0; j < n; j++)
-	A[i][j] = (DATA_TYPE) (i*j % n) / n;
-    }
-}
+/* Include array initialization, shared by all versions. */
+#include <mvt_init.h>
 
 
 /* DCE code. Must scan the entire live-out data.
    Can be used also to check the correctness of the output. */
 static
-void print_array(int n,
+void print_array(INDEX_TYPE n,
 		 DATA_TYPE POLYBENCH_1D(x1,N,n),
 		 DATA_TYPE POLYBENCH_1D(x2,N,n))
 
 {
-  int i;
+  INDEX_TYPE i;
 
   POLYBENCH_DUMP_START;
   POLYBENCH_DUMP_BEGIN("x1");
@@ -75,14 +56,14 @@ void print_array(int n,
 /* Main computational kernel. The whole function will be timed,
    including the call and return. */
 static
-void kernel_mvt(int n,
+void kernel_mvt(INDEX_TYPE n,
 		DATA_TYPE POLYBENCH_1D(x1,N,n),
 		DATA_TYPE POLYBENCH_1D(x2,N,n),
 		DATA_TYPE POLYBENCH_1D(y_1,N,n),
 		DATA_TYPE POLYBENCH_1D(y_2,N,n),
 		DATA_TYPE POLYBENCH_2D(A,N,N,n,n))
 {
-  int i, j;
+  INDEX_TYPE i, j;
 
 #pragma scop
   i = 0;
@@ -112,7 +93,7 @@ void kernel_mvt(int n,
 int main(int argc, char** argv)
 {
   /* Retrieve problem size. */
-  int n = N;
+  INDEX_TYPE n = N;
 
   /* Variable declaration/allocation. */
   POLYBENCH_2D_ARRAY_DECL(A, DATA_TYPE, N, N, n, n);
@@ -123,12 +104,16 @@ int main(int argc, char** argv)
 
 
   /* Initialize array(s). */
-  init_array (n,
+  polybench_cached_init (init_array (n,
 	      POLYBENCH_ARRAY(x1),
 	      POLYBENCH_ARRAY(x2),
 	      POLYBENCH_ARRAY(y_1),
 	      POLYBENCH_ARRAY(y_2),
-	      POLYBENCH_ARRAY(A));
+	      POLYBENCH_ARRAY(A)));
+
+  /* Work and memory traffic of the kernel, see the header. */
+  polybench_set_program_flops (POLYBENCH_PROGRAM_FLOPS);
+  polybench_set_program_bytes (POLYBENCH_PROGRAM_BYTES);
 
   /* Start timer. */
   polybench_start_instruments;
@@ -21,34 +21,19 @@
 #include <bicg.h>
 
 
-/* Array initialization. */
-static
-void init_array (int m, int n,
-		 DATA_TYPE POLYBENCH_2D(A,N,M,n,m),
-		 DATA_TYPE POLYBENCH_1D(r,N,n),
-		 DATA_TYPE POLYBENCH_1D(p,M,m))
-{
-  int i, j;
-
-  for (i = 0; i < m; i++)
-    p[i] = (DATA_TYPE)(i % m) / m;
-  for (i = 0; i < n; i++) {
-    r[i] = (DATA_TYPE)(i % n) / n;
-    for (j = 0; j < m; j++)
-      A[i][j] = (DATA_TYPE) (i*(j+1) % n)/n;
-  }
-}
+/* Include array initialization, shared by all versions. */
+#include <bicg_init.h>
 
 
 /* DCE code. Must scan the entire live-out data.
    Can be used also to check the correctness of the output. */
 static
-void print_array(int m, int n,
+void print_array(INDEX_TYPE m, INDEX_TYPE n,
 		 DATA_TYPE POLYBENCH_1D(s,M,m),
 		 DATA_TYPE POLYBENCH_1D(q,N,n))
 
 {
-  int i;
+  INDEX_TYPE i;
 
   POLYBENCH_DUMP_START;
   POLYBENCH_DUMP_BEGIN("s");
@@ -70,14 +55,14 @@ void print_array(int m, int n,
 /* Main computational kernel. The whole function will be timed,
    including the call and return. */
 static
-void kernel_bicg(int m, int n,
+void kernel_bicg(INDEX_TYPE m, INDEX_TYPE n,
 		 DATA_TYPE POLYBENCH_2D(A,N,M,n,m),
 		 DATA_TYPE POLYBENCH_1D(s,M,m),
 		 DATA_TYPE POLYBENCH_1D(q,N,n),
 		 DATA_TYPE POLYBENCH_1D(p,M,m),
 		 DATA_TYPE POLYBENCH_1D(r,N,n))
 {
-  int i, j;
+  INDEX_TYPE i, j;
 
 #pragma scop
 
@@ -127,8 +112,8 @@ void kernel_bicg(int m, int n,
 int main(int argc, char** argv)
 {
   /* Retrieve problem size. */
-  int n = N;
-  int m = M;
+  INDEX_TYPE n = N;
+  INDEX_TYPE m = M;
 
   /* Variable declaration/allocation. */
   POLYBENCH_2D_ARRAY_DECL(A, DATA_TYPE, N, M, n, m);
@@ -138,10 +123,16 @@ int main(int argc, char** argv)
   POLYBENCH_1D_ARRAY_DECL(r, DATA_TYPE, N, n);
 
   /* Initialize array(s). */
-  init_array (m, n,
+  polybench_cached_init (init_array (m, n,
 	      POLYBENCH_ARRAY(A),
+	      POLYBENCH_ARRAY(s),
+	      POLYBENCH_ARRAY(q),
 	      POLYBENCH_ARRAY(r),
-	      POLYBENCH_ARRAY(p));
+	      POLYBENCH_ARRAY(p)));
+
+  /* Work and memory traffic of the kernel, see the header. */
+  polybench_set_program_flops (POLYBENCH_PROGRAM_FLOPS);
+  polybench_set_program_bytes (POLYBENCH_PROGRAM_BYTES);
 
   /* Start timer. */
   polybench_start_instruments;
@@ -20,33 +20,18 @@
 /* Default data type is double, default size is N=1024. */
 #include <colormap.h>
 
-/* Array initialization. */
-static
-void init_array(int n,
-    DATA_TYPE POLYBENCH_1D(R,N,n),
-    DATA_TYPE POLYBENCH_1D(G,N,n),
-    DATA_TYPE POLYBENCH_1D(B,N,n)) {
-
-    int i;
-
-    for (i = 0; i < n; i++)
-        R[i] = (DATA_TYPE) ((i*i+1) % n) / (5*n);
-    for (i = 0; i < n; i++)
-        G[i] = (DATA_TYPE) ((i*(i+1)+2) % n) / (5*n);
-    for (i = 0; i < n; i++)
-        B[i] = (DATA_TYPE) (i*(i+3) % n) / (5*n);
-
-}
+/* Include array initialization, shared by all versions. */
+#include <colormap_init.h>
 
 /* DCE code. Must scan the entire live-out data.
    Can be used also to check the correctness of the output. */
 static
-void print_array(int n,
+void print_array(INDEX_TYPE n,
      DATA_TYPE POLYBENCH_1D(R,N,n),
      DATA_TYPE POLYBENCH_1D(G,N,n),
      DATA_TYPE POLYBENCH_1D(B,N,n))
 {
-  int i, j;
+  INDEX_TYPE i, j;
 
   POLYBENCH_DUMP_START;
   POLYBENCH_DUMP_BEGIN("R");
@@ -74,12 +59,12 @@ void print_array(int n,
 /* Main computational kernel. The whole function will be timed,
    including the call and return. */
 static
-void kernel_colormap(int n,
+void kernel_colormap(INDEX_TYPE n,
     DATA_TYPE POLYBENCH_1D(R,N,n),
     DATA_TYPE POLYBENCH_1D(G,N,n),
     DATA_TYPE POLYBENCH_1D(B,N,n))
 {
-  int i;
+  INDEX_TYPE i;
 
 #pragma scop
 
@@ -121,7 +106,7 @@ void kernel_colormap(int n,
 int main(int argc, char** argv)
 {
   /* Retrieve problem size. */
-  int n = N;
+  INDEX_TYPE n = N;
 
   /* Variable declaration/allocation. */
   POLYBENCH_1D_ARRAY_DECL(R,DATA_TYPE,N,n);
@@ -129,7 +114,11 @@ int main(int argc, char** argv)
   POLYBENCH_1D_ARRAY_DECL(B,DATA_TYPE,N,n);
 
   /* Initialize array(s). */
-  init_array (n, POLYBENCH_ARRAY(R), POLYBENCH_ARRAY(G), POLYBENCH_ARRAY(B));
+  polybench_cached_init (init_array (n, POLYBENCH_ARRAY(R), POLYBENCH_ARRAY(G), POLYBENCH_ARRAY(B)));
+
+  /* Work and memory traffic of the kernel, see the header. */
+  polybench_set_program_flops (POLYBENCH_PROGRAM_FLOPS);
+  polybench_set_program_bytes (POLYBENCH_PROGRAM_BYTES);
 
   /* Start timer. */
   polybench_start_instruments;
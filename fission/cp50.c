@@ -21,28 +21,19 @@
 /* Default data type is double, default size is N=1024. */
 #include <cp50.h>
 
-/* Array initialization. */
-static
-void init_array(int ls, int ol,
-                DATA_TYPE POLYBENCH_2D(out,LS,OL,ls,ol)) {
-    int i, j;
-
-    // simulate gdev_prn_copy_scan_lines procedure
-    for (i = 0; i < ls; i++)
-        for (j = 0; j < ol; j++)
-            out[i][j] = (DATA_TYPE) ((i*j+1));
-}
+/* Include array initialization, shared by all versions. */
+#include <cp50_init.h>
 
 
 /* DCE code. Must scan the entire live-out data.
    Can be used also to check the correctness of the output. */
 static
-void print_array(int xy,
+void print_array(INDEX_TYPE xy,
             DATA_TYPE POLYBENCH_1D(RPLANE,XY,xy),
             DATA_TYPE POLYBENCH_1D(GPLANE,XY,xy),
             DATA_TYPE POLYBENCH_1D(BPLANE,XY,xy))
 {
-    int i, j;
+    INDEX_TYPE i, j;
 
     POLYBENCH_DUMP_START;
     POLYBENCH_DUMP_BEGIN("RPLANE");
@@ -71,14 +62,15 @@ void print_array(int xy,
    including the call and return. */
 static
 void kernel_cp50(
-        int X_PIXEL, int FIRST_COLUMN, int FIRST_LINE, int LAST_LINE,
+        INDEX_TYPE X_PIXEL, INDEX_TYPE FIRST_COLUMN, INDEX_TYPE FIRST_LINE, INDEX_TYPE LAST_LINE,
+        INDEX_TYPE ls, INDEX_TYPE ol, INDEX_TYPE xy,
         DATA_TYPE POLYBENCH_2D(out,LS,OL,ls,ol),
         DATA_TYPE POLYBENCH_1D(RPLANE,XY,xy),
         DATA_TYPE POLYBENCH_1D(GPLANE,XY,xy),
         DATA_TYPE POLYBENCH_1D(BPLANE,XY,xy))
 {
-    int lnum = FIRST_LINE, last = LAST_LINE;
-    int i, col;
+    INDEX_TYPE lnum = FIRST_LINE, last = LAST_LINE;
+    INDEX_TYPE i, col;
 
 #pragma scop
 
@@ -87,6 +79,7 @@ void kernel_cp50(
 {
     #pragma omp single nowait
     {
+        polybench_trace_begin("RPLANE");
         lnum = FIRST_LINE;
         while (lnum <= last) {
             for (i = 0; i < X_PIXEL; i++) {
@@ -95,10 +88,12 @@ void kernel_cp50(
             }
             lnum++;
         }
+        polybench_trace_end("RPLANE");
     }
 
     #pragma omp single nowait
     {
+        polybench_trace_begin("GPLANE");
         lnum = FIRST_LINE;
         while (lnum <= last) {
             for (i = 0; i < X_PIXEL; i++) {
@@ -107,10 +102,12 @@ void kernel_cp50(
             }
             lnum++;
         }
+        polybench_trace_end("GPLANE");
     }
 
     #pragma omp single nowait
     {
+        polybench_trace_begin("BPLANE");
         lnum = FIRST_LINE;
         while (lnum <= last) {
             for (i = 0; i < X_PIXEL; i++) {
@@ -119,6 +116,7 @@ void kernel_cp50(
             }
             lnum++;
         }
+        polybench_trace_end("BPLANE");
     }
 }
 #pragma endscop
@@ -129,14 +127,14 @@ void kernel_cp50(
 int main(int argc, char** argv)
 {
   /* Retrieve problem size. */
-  int x = X;
-  int y = Y;
-  int xy = XY;
-  int fc = FC;
-  int ls = LS;
-  int fl = FL;
-  int ll = LL;
-  int ol = OL;
+  INDEX_TYPE x = X;
+  INDEX_TYPE y = Y;
+  INDEX_TYPE xy = XY;
+  INDEX_TYPE fc = FC;
+  INDEX_TYPE ls = LS;
+  INDEX_TYPE fl = FL;
+  INDEX_TYPE ll = LL;
+  INDEX_TYPE ol = OL;
 
   /* Variable declaration/allocation. */
     POLYBENCH_2D_ARRAY_DECL(out, DATA_TYPE,LS,OL,ls,ol);
@@ -145,13 +143,17 @@ int main(int argc, char** argv)
     POLYBENCH_1D_ARRAY_DECL(BPLANE,DATA_TYPE,XY,xy);
 
   /* Initialize array(s). */
-  init_array (ls, ol, POLYBENCH_ARRAY(out));
+  polybench_cached_init (init_array (ls, ol, POLYBENCH_ARRAY(out)));
+
+  /* Work and memory traffic of the kernel, see the header. */
+  polybench_set_program_flops (POLYBENCH_PROGRAM_FLOPS);
+  polybench_set_program_bytes (POLYBENCH_PROGRAM_BYTES);
 
   /* Start timer. */
   polybench_start_instruments;
 
   /* Run kernel. */
-  kernel_cp50(x, fc, fl, ll,
+  kernel_cp50(x, fc, fl, ll, ls, ol, xy,
               POLYBENCH_ARRAY(out),
               POLYBENCH_ARRAY(RPLANE),
               POLYBENCH_ARRAY(GPLANE),
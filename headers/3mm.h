@@ -11,7 +11,7 @@
 # define _3MM_H
 
 /* Default to LARGE_DATASET. */
-# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(MEDIUM_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET)
+# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(MEDIUM_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET) && !defined(HUGE_DATASET)
 #  define LARGE_DATASET
 # endif
 
@@ -57,9 +57,36 @@
 #   define NM 2400
 #  endif
 
+#  ifdef HUGE_DATASET
+#   define NI 12800
+#   define NJ 14400
+#   define NK 16000
+#   define NL 17600
+#   define NM 19200
+#  endif
+
 
 #endif /* !(NI NJ NK NL NM) */
 
+/* Sizes read at run time, see POLYBENCH_DYNAMIC_SIZE. */
+# ifdef POLYBENCH_DYNAMIC_SIZES
+POLYBENCH_DYNAMIC_SIZE(NI)
+#  undef NI
+#  define NI polybench_size_NI
+POLYBENCH_DYNAMIC_SIZE(NJ)
+#  undef NJ
+#  define NJ polybench_size_NJ
+POLYBENCH_DYNAMIC_SIZE(NK)
+#  undef NK
+#  define NK polybench_size_NK
+POLYBENCH_DYNAMIC_SIZE(NL)
+#  undef NL
+#  define NL polybench_size_NL
+POLYBENCH_DYNAMIC_SIZE(NM)
+#  undef NM
+#  define NM polybench_size_NM
+# endif
+
 # define _PB_NI POLYBENCH_LOOP_BOUND(NI,ni)
 # define _PB_NJ POLYBENCH_LOOP_BOUND(NJ,nj)
 # define _PB_NK POLYBENCH_LOOP_BOUND(NK,nk)
@@ -67,6 +94,17 @@
 # define _PB_NM POLYBENCH_LOOP_BOUND(NM,nm)
 
 
+/* Weak scaling (run.sh -W): the work is cubic in these sizes. */
+# define POLYBENCH_WEAK_DIMS "NI NJ NK NL NM"
+# define POLYBENCH_WEAK_DEGREE 3
+
+/* Models of the kernel (cf. polybench.h): the traffic counts A, B, C,
+   D read once, E, F, G written once. */
+# define POLYBENCH_PROGRAM_FLOPS (2.0*NI*NJ*NK + 2.0*NJ*NL*NM + 2.0*NI*NL*NJ)
+# define POLYBENCH_PROGRAM_BYTES \
+  (sizeof(DATA_TYPE) * (1.0*NI*NK + 1.0*NK*NJ + 1.0*NJ*NM + \
+   1.0*NM*NL + 1.0*NI*NJ + 1.0*NJ*NL + 1.0*NI*NL))
+
 /* Default data type */
 # if !defined(DATA_TYPE_IS_INT) && !defined(DATA_TYPE_IS_FLOAT) && !defined(DATA_TYPE_IS_DOUBLE)
 #  define DATA_TYPE_IS_DOUBLE
@@ -0,0 +1,75 @@
+/**
+ * 3mm_init.h: array initialization of 3mm, shared by the original,
+ * fission and alt versions so that they all run on the same data.
+ */
+#ifndef _3MM_INIT_H
+# define _3MM_INIT_H
+
+/* Array initialization, parallel over the rows. Along a row, each
+   remainder grows by i (modulo the divisor) at each step: it is carried
+   rather than recomputed, which keeps the integer division out of the
+   inner loops. The values are the same as computed directly. */
+static
+void init_array(INDEX_TYPE ni, INDEX_TYPE nj, INDEX_TYPE nk, INDEX_TYPE nl, INDEX_TYPE nm,
+        DATA_TYPE POLYBENCH_2D(A,NI,NK,ni,nk),
+        DATA_TYPE POLYBENCH_2D(B,NK,NJ,nk,nj),
+        DATA_TYPE POLYBENCH_2D(C,NJ,NM,nj,nm),
+        DATA_TYPE POLYBENCH_2D(D,NM,NL,nm,nl))
+{
+INDEX_TYPE i, j, v, s;
+
+/* A[i][j] = ((i*j+1) % ni) / (5*ni) */
+#pragma omp parallel for private (j, v, s) schedule (static)
+for (i = 0; i < ni; i++)
+{
+    v = 1 % ni;
+    s = i % ni;
+    for (j = 0; j < nk; j++)
+    {
+        A[i][j] = (DATA_TYPE) v / (5*ni);
+        v += s;
+        v -= v >= ni ? ni : 0;
+    }
+}
+/* B[i][j] = ((i*(j+1)+2) % nj) / (5*nj) */
+#pragma omp parallel for private (j, v, s) schedule (static)
+for (i = 0; i < nk; i++)
+{
+    v = (i+2) % nj;
+    s = i % nj;
+    for (j = 0; j < nj; j++)
+    {
+        B[i][j] = (DATA_TYPE) v / (5*nj);
+        v += s;
+        v -= v >= nj ? nj : 0;
+    }
+}
+/* C[i][j] = (i*(j+3) % nl) / (5*nl) */
+#pragma omp parallel for private (j, v, s) schedule (static)
+for (i = 0; i < nj; i++)
+{
+    v = i*3 % nl;
+    s = i % nl;
+    for (j = 0; j < nm; j++)
+    {
+        C[i][j] = (DATA_TYPE) v / (5*nl);
+        v += s;
+        v -= v >= nl ? nl : 0;
+    }
+}
+/* D[i][j] = ((i*(j+2)+2) % nk) / (5*nk) */
+#pragma omp parallel for private (j, v, s) schedule (static)
+for (i = 0; i < nm; i++)
+{
+    v = (i*2+2) % nk;
+    s = i % nk;
+    for (j = 0; j < nl; j++)
+    {
+        D[i][j] = (DATA_TYPE) v / (5*nk);
+        v += s;
+        v -= v >= nk ? nk : 0;
+    }
+}
+}
+
+#endif /* !_3MM_INIT_H */
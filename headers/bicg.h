@@ -11,7 +11,7 @@
 # define _BICG_H
 
 /* Default to LARGE_DATASET. */
-# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(MEDIUM_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET)
+# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(MEDIUM_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET) && !defined(HUGE_DATASET)
 #  define LARGE_DATASET
 # endif
 
@@ -42,13 +42,38 @@
 #   define N 2200
 #  endif
 
+#  ifdef HUGE_DATASET
+#   define M 28800
+#   define N 35200
+#  endif
+
 
 #endif /* !(M N) */
 
+/* Sizes read at run time, see POLYBENCH_DYNAMIC_SIZE. */
+# ifdef POLYBENCH_DYNAMIC_SIZES
+POLYBENCH_DYNAMIC_SIZE(M)
+#  undef M
+#  define M polybench_size_M
+POLYBENCH_DYNAMIC_SIZE(N)
+#  undef N
+#  define N polybench_size_N
+# endif
+
 # define _PB_M POLYBENCH_LOOP_BOUND(M,m)
 # define _PB_N POLYBENCH_LOOP_BOUND(N,n)
 
 
+/* Weak scaling (run.sh -W): the work is quadratic in these sizes. */
+# define POLYBENCH_WEAK_DIMS "M N"
+# define POLYBENCH_WEAK_DEGREE 2
+
+/* Models of the kernel (cf. polybench.h): the traffic counts A, r, p
+   read once, s, q written once. */
+# define POLYBENCH_PROGRAM_FLOPS (4.0*N*M)
+# define POLYBENCH_PROGRAM_BYTES \
+  (sizeof(DATA_TYPE) * (1.0*N*M + 2.0*N + 2.0*M))
+
 /* Default data type */
 # if !defined(DATA_TYPE_IS_INT) && !defined(DATA_TYPE_IS_FLOAT) && !defined(DATA_TYPE_IS_DOUBLE)
 #  define DATA_TYPE_IS_DOUBLE
@@ -0,0 +1,43 @@
+/**
+ * bicg_init.h: array initialization of bicg, shared by the original,
+ * fission and alt versions so that they all run on the same data.
+ */
+#ifndef _BICG_INIT_H
+# define _BICG_INIT_H
+
+/* Array initialization, parallel over the rows. Along a row, the
+   remainder of i*(j+1) by n grows by i at each step: it is carried
+   rather than recomputed, which keeps the integer division out of the
+   inner loop. The values are the same as computed directly.
+   The outputs are zeroed here too, so that with the local NUMA policy
+   they are first touched along the kernel's loops: s, indexed by the
+   columns, with p, and q with the rows. */
+static
+void init_array (INDEX_TYPE m, INDEX_TYPE n,
+		 DATA_TYPE POLYBENCH_2D(A,N,M,n,m),
+		 DATA_TYPE POLYBENCH_1D(s,M,m),
+		 DATA_TYPE POLYBENCH_1D(q,N,n),
+		 DATA_TYPE POLYBENCH_1D(r,N,n),
+		 DATA_TYPE POLYBENCH_1D(p,M,m))
+{
+  INDEX_TYPE i, j, v, d;
+
+#pragma omp parallel for simd schedule (static)
+  for (i = 0; i < m; i++) {
+    p[i] = (DATA_TYPE)(i % m) / m;
+    s[i] = 0;
+  }
+#pragma omp parallel for private (j, v, d) schedule (static)
+  for (i = 0; i < n; i++) {
+    q[i] = 0;
+    r[i] = (DATA_TYPE)(i % n) / n;
+    d = v = i % n;
+    for (j = 0; j < m; j++) {
+      A[i][j] = (DATA_TYPE) v / n;
+      v += d;
+      v -= v >= n ? n : 0;
+    }
+  }
+}
+
+#endif /* !_BICG_INIT_H */
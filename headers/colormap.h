@@ -2,7 +2,7 @@
 # define _COLORMAP_H
 
 /* Default to LARGE_DATASET. */
-# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(MEDIUM_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET)
+# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(MEDIUM_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET) && !defined(HUGE_DATASET)
 #  define LARGE_DATASET
 #  define LARGE_DATASET
 # endif
@@ -29,12 +29,32 @@
 #   define N 268435456
 #  endif
 
+#  ifdef HUGE_DATASET
+#   define N 2147483648 /* 2^31 */
+#  endif
+
 
 #endif /* !(N) */
 
+/* Sizes read at run time, see POLYBENCH_DYNAMIC_SIZE. */
+# ifdef POLYBENCH_DYNAMIC_SIZES
+POLYBENCH_DYNAMIC_SIZE(N)
+#  undef N
+#  define N polybench_size_N
+# endif
+
 # define _PB_N POLYBENCH_LOOP_BOUND(N,n)
 
 
+/* Weak scaling (run.sh -W): the work is linear in N. */
+# define POLYBENCH_WEAK_DIMS "N"
+# define POLYBENCH_WEAK_DEGREE 1
+
+/* Models of the kernel (cf. polybench.h): the traffic counts R, G, B
+   read and written. */
+# define POLYBENCH_PROGRAM_FLOPS (6.0*N)
+# define POLYBENCH_PROGRAM_BYTES (sizeof(DATA_TYPE) * (6.0*N))
+
 /* Default data type */
 # if !defined(DATA_TYPE_IS_INT) && !defined(DATA_TYPE_IS_FLOAT) && !defined(DATA_TYPE_IS_DOUBLE)
 #  define DATA_TYPE_IS_DOUBLE
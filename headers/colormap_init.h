@@ -0,0 +1,29 @@
+/**
+ * colormap_init.h: array initialization of colormap, shared by the
+ * original, fission and alt versions so that they all run on the same
+ * data.
+ */
+#ifndef _COLORMAP_INIT_H
+# define _COLORMAP_INIT_H
+
+/* Array initialization, parallel, the three channels in one pass. The
+   products are computed on 64 bits: with int indices, i*i overflows
+   from N = 46341 on, and the values then depended on the compiler. */
+static
+void init_array(INDEX_TYPE n,
+    DATA_TYPE POLYBENCH_1D(R,N,n),
+    DATA_TYPE POLYBENCH_1D(G,N,n),
+    DATA_TYPE POLYBENCH_1D(B,N,n)) {
+
+    INDEX_TYPE i;
+
+#pragma omp parallel for schedule (static)
+    for (i = 0; i < n; i++) {
+        R[i] = (DATA_TYPE) (((unsigned long long) i*i+1) % n) / (5*n);
+        G[i] = (DATA_TYPE) (((unsigned long long) i*(i+1)+2) % n) / (5*n);
+        B[i] = (DATA_TYPE) ((unsigned long long) i*(i+3) % n) / (5*n);
+    }
+
+}
+
+#endif /* !_COLORMAP_INIT_H */
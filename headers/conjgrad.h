@@ -2,7 +2,7 @@
 # define _CONJGRAD_H
 
 /* Default to LARGE_DATASET. */
-# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(MEDIUM_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET)
+# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(MEDIUM_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET) && !defined(HUGE_DATASET)
 #  define LARGE_DATASET
 #  define LARGE_DATASET
 # endif
@@ -34,11 +34,36 @@
 #   define NITER 75
 #  endif
 
+#  ifdef HUGE_DATASET
+#   define NA 1073741824
+#   define NITER 15
+#  endif
+
 #endif /* !(NA NITER */
 
+/* Sizes read at run time, see POLYBENCH_DYNAMIC_SIZE. */
+# ifdef POLYBENCH_DYNAMIC_SIZES
+POLYBENCH_DYNAMIC_SIZE(NA)
+#  undef NA
+#  define NA polybench_size_NA
+POLYBENCH_DYNAMIC_SIZE(NITER)
+#  undef NITER
+#  define NITER polybench_size_NITER
+# endif
+
 # define _PB_NITER POLYBENCH_LOOP_BOUND(NITER,niter)
 # define _PB_NA POLYBENCH_LOOP_BOUND(NA,na)
 
+/* Weak scaling (run.sh -W): the work is linear in NA. NITER is kept. */
+# define POLYBENCH_WEAK_DIMS "NA"
+# define POLYBENCH_WEAK_DEGREE 1
+
+/* Models of the kernel (cf. polybench.h): the traffic counts per
+   iteration, r, then p and q, then z, p, r, q streamed, z and r
+   written. */
+# define POLYBENCH_PROGRAM_FLOPS (NITER * (8.0*NA + 1))
+# define POLYBENCH_PROGRAM_BYTES (sizeof(DATA_TYPE) * (NITER * 9.0*NA))
+
 /* Default data type */
 # if !defined(DATA_TYPE_IS_INT) && !defined(DATA_TYPE_IS_FLOAT) && !defined(DATA_TYPE_IS_DOUBLE)
 #  define DATA_TYPE_IS_DOUBLE
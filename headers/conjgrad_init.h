@@ -0,0 +1,28 @@
+/**
+ * conjgrad_init.h: array initialization of conjgrad, shared by the
+ * original, fission and alt versions so that they all run on the same
+ * data.
+ */
+#ifndef _CONJGRAD_INIT_H
+# define _CONJGRAD_INIT_H
+
+/* Array initialization, parallel and vectorized. */
+static
+void init_array(INDEX_TYPE na,
+    DATA_TYPE POLYBENCH_1D(p,NA,na),
+    DATA_TYPE POLYBENCH_1D(q,NA,na),
+    DATA_TYPE POLYBENCH_1D(z,NA,na),
+    DATA_TYPE POLYBENCH_1D(r,NA,na))
+{
+    INDEX_TYPE j;
+
+#pragma omp parallel for simd schedule (static)
+    for (j = 0; j < na; j++) {
+        q[j] = 0.00001 *j;
+        z[j] = 0.00002 *j;
+        r[j] = 0.00003 *j;
+        p[j] = r[j];
+    }
+}
+
+#endif /* !_CONJGRAD_INIT_H */
@@ -2,7 +2,7 @@
 # define _CP50_H
 
 /* Default to LARGE_DATASET. */
-# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(MEDIUM_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET)
+# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(MEDIUM_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET) && !defined(HUGE_DATASET)
 #  define LARGE_DATASET
 #  define LARGE_DATASET
 # endif
@@ -48,13 +48,51 @@
 #   define FL 360
 #   define LL 2350
 #  endif
+
+#  ifdef HUGE_DATASET
+#   define X 9472
+#   define Y 16000
+#   define FC 3600
+#   define FL 2880
+#   define LL 18800
+#  endif
 #endif /* !(X Y FC FL LL) */
 
+/* Sizes read at run time, see POLYBENCH_DYNAMIC_SIZE. */
+# ifdef POLYBENCH_DYNAMIC_SIZES
+POLYBENCH_DYNAMIC_SIZE(X)
+#  undef X
+#  define X polybench_size_X
+POLYBENCH_DYNAMIC_SIZE(Y)
+#  undef Y
+#  define Y polybench_size_Y
+POLYBENCH_DYNAMIC_SIZE(FC)
+#  undef FC
+#  define FC polybench_size_FC
+POLYBENCH_DYNAMIC_SIZE(FL)
+#  undef FL
+#  define FL polybench_size_FL
+POLYBENCH_DYNAMIC_SIZE(LL)
+#  undef LL
+#  define LL polybench_size_LL
+# endif
+
 #   define LS (X*3+FC*2)   /* line size */
 #   define XY (X*Y)
 #   define OL (LL-FL)      /* data Y height */
 
 
+/* Weak scaling (run.sh -W): the work is quadratic in these sizes. The
+   page and its margins grow together. */
+# define POLYBENCH_WEAK_DIMS "X Y FC FL LL"
+# define POLYBENCH_WEAK_DEGREE 2
+
+/* Models of the kernel (cf. polybench.h): the traffic counts 3
+   channels of X pixels per line read from out, written to the planes;
+   no flops. */
+# define POLYBENCH_PROGRAM_FLOPS (0.0)
+# define POLYBENCH_PROGRAM_BYTES (sizeof(DATA_TYPE) * (6.0*X*(LL-FL+1)))
+
 /* Default data type */
 # if !defined(DATA_TYPE_IS_INT) && !defined(DATA_TYPE_IS_FLOAT) && !defined(DATA_TYPE_IS_DOUBLE)
 #  define DATA_TYPE_IS_DOUBLE
@@ -0,0 +1,23 @@
+/**
+ * cp50_init.h: array initialization of cp50, shared by the original,
+ * fission and alt versions so that they all run on the same data.
+ */
+#ifndef _CP50_INIT_H
+# define _CP50_INIT_H
+
+/* Array initialization, parallel over the scan lines, vectorized
+   along them. */
+static
+void init_array(INDEX_TYPE ls, INDEX_TYPE ol,
+                DATA_TYPE POLYBENCH_2D(out,LS,OL,ls,ol)) {
+    INDEX_TYPE i, j;
+
+    // simulate gdev_prn_copy_scan_lines procedure
+#pragma omp parallel for private (j) schedule (static)
+    for (i = 0; i < ls; i++)
+#pragma omp simd
+        for (j = 0; j < ol; j++)
+            out[i][j] = (DATA_TYPE) ((i*j+1));
+}
+
+#endif /* !_CP50_INIT_H */
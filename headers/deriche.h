@@ -11,7 +11,7 @@
 # define _DERICHE_H
 
 /* Default to LARGE_DATASET. */
-# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(MEDIUM_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET)
+# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(MEDIUM_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET) && !defined(HUGE_DATASET)
 #  define LARGE_DATASET
 # endif
 
@@ -42,13 +42,37 @@
 #   define H 4320
 #  endif
 
+#  ifdef HUGE_DATASET
+#   define W 30720
+#   define H 17280
+#  endif
+
 
 #endif /* !(W H) */
 
+/* Sizes read at run time, see POLYBENCH_DYNAMIC_SIZE. */
+# ifdef POLYBENCH_DYNAMIC_SIZES
+POLYBENCH_DYNAMIC_SIZE(W)
+#  undef W
+#  define W polybench_size_W
+POLYBENCH_DYNAMIC_SIZE(H)
+#  undef H
+#  define H polybench_size_H
+# endif
+
 # define _PB_W POLYBENCH_LOOP_BOUND(W,w)
 # define _PB_H POLYBENCH_LOOP_BOUND(H,h)
 
 
+/* Weak scaling (run.sh -W): the work is quadratic in these sizes. */
+# define POLYBENCH_WEAK_DIMS "W H"
+# define POLYBENCH_WEAK_DEGREE 2
+
+/* Models of the kernel (cf. polybench.h): the traffic counts imgIn
+   read once, y1 written once. */
+# define POLYBENCH_PROGRAM_FLOPS (7.0*W*H)
+# define POLYBENCH_PROGRAM_BYTES (sizeof(DATA_TYPE) * (2.0*W*H))
+
 /* Default data type */
 # if !defined(DATA_TYPE_IS_INT) && !defined(DATA_TYPE_IS_FLOAT) && !defined(DATA_TYPE_IS_DOUBLE)
 #  define DATA_TYPE_IS_FLOAT
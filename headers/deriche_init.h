@@ -0,0 +1,32 @@
+/**
+ * deriche_init.h: array initialization of deriche, shared by the
+ * original, fission and alt versions so that they all run on the same
+ * data.
+ */
+#ifndef _DERICHE_INIT_H
+# define _DERICHE_INIT_H
+
+/* Array initialization, parallel over the columns, vectorized along
+   them (the remainder by 65536 needs no division). The output is
+   zeroed in the same loop, so that with the local NUMA policy it is
+   first touched along the kernel's loops too. */
+static
+void init_array (INDEX_TYPE w, INDEX_TYPE h, DATA_TYPE* alpha,
+        DATA_TYPE POLYBENCH_2D(imgIn,W,H,w,h),
+        DATA_TYPE POLYBENCH_2D(imgOut,W,H,w,h))
+{
+    INDEX_TYPE i, j;
+
+    *alpha=0.25; //parameter of the filter
+
+    //input should be between 0 and 1 (grayscale image pixel)
+#pragma omp parallel for private (j) schedule (static)
+    for (i = 0; i < w; i++)
+#pragma omp simd
+    for (j = 0; j < h; j++) {
+        imgIn[i][j] = (DATA_TYPE) ((313*i+991*j)%65536) / 65535.0f;
+        imgOut[i][j] = 0;
+    }
+}
+
+#endif /* !_DERICHE_INIT_H */
@@ -11,7 +11,7 @@
 # define _FDTD_2D_H
 
 /* Default to LARGE_DATASET. */
-# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(MEDIUM_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET)
+# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(MEDIUM_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET) && !defined(HUGE_DATASET)
 #  define LARGE_DATASET
 # endif
 
@@ -47,14 +47,46 @@
 #   define NY 2600
 #  endif
 
+#  ifdef HUGE_DATASET
+#   define TMAX 100
+#   define NX 16000
+#   define NY 20800
+#  endif
+
 
 #endif /* !(TMAX NX NY) */
 
+/* Sizes read at run time, see POLYBENCH_DYNAMIC_SIZE. */
+# ifdef POLYBENCH_DYNAMIC_SIZES
+POLYBENCH_DYNAMIC_SIZE(TMAX)
+#  undef TMAX
+#  define TMAX polybench_size_TMAX
+POLYBENCH_DYNAMIC_SIZE(NX)
+#  undef NX
+#  define NX polybench_size_NX
+POLYBENCH_DYNAMIC_SIZE(NY)
+#  undef NY
+#  define NY polybench_size_NY
+# endif
+
 # define _PB_TMAX POLYBENCH_LOOP_BOUND(TMAX,tmax)
 # define _PB_NX POLYBENCH_LOOP_BOUND(NX,nx)
 # define _PB_NY POLYBENCH_LOOP_BOUND(NY,ny)
 
 
+/* Weak scaling (run.sh -W): the work is quadratic in these sizes.
+   TMAX is kept. */
+# define POLYBENCH_WEAK_DIMS "NX NY"
+# define POLYBENCH_WEAK_DEGREE 2
+
+/* Models of the kernel (cf. polybench.h): the traffic counts per time
+   step, ey and ex read and written with hz, then hz read and written
+   with ex, ey. */
+# define POLYBENCH_PROGRAM_FLOPS \
+  (TMAX * (3.0*(NX-1)*NY + 3.0*NX*(NY-1) + 5.0*(NX-1)*(NY-1)))
+# define POLYBENCH_PROGRAM_BYTES \
+  (sizeof(DATA_TYPE) * (TMAX * (10.0*NX*NY + NY)))
+
 /* Default data type */
 # if !defined(DATA_TYPE_IS_INT) && !defined(DATA_TYPE_IS_FLOAT) && !defined(DATA_TYPE_IS_DOUBLE)
 #  define DATA_TYPE_IS_DOUBLE
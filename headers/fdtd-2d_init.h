@@ -0,0 +1,35 @@
+/**
+ * fdtd-2d_init.h: array initialization of fdtd-2d, shared by the
+ * original, fission and alt versions so that they all run on the same
+ * data.
+ */
+#ifndef _FDTD_2D_INIT_H
+# define _FDTD_2D_INIT_H
+
+/* Array initialization, parallel over the rows of the fields,
+   vectorized along them. */
+static
+void init_array (INDEX_TYPE tmax,
+		 INDEX_TYPE nx,
+		 INDEX_TYPE ny,
+		 DATA_TYPE POLYBENCH_2D(ex,NX,NY,nx,ny),
+		 DATA_TYPE POLYBENCH_2D(ey,NX,NY,nx,ny),
+		 DATA_TYPE POLYBENCH_2D(hz,NX,NY,nx,ny),
+		 DATA_TYPE POLYBENCH_1D(_fict_,TMAX,tmax))
+{
+  INDEX_TYPE i, j;
+
+  for (i = 0; i < tmax; i++)
+    _fict_[i] = (DATA_TYPE) i;
+#pragma omp parallel for private (j) schedule (static)
+  for (i = 0; i < nx; i++)
+#pragma omp simd
+    for (j = 0; j < ny; j++)
+      {
+	ex[i][j] = ((DATA_TYPE) i*(j+1)) / nx;
+	ey[i][j] = ((DATA_TYPE) i*(j+2)) / ny;
+	hz[i][j] = ((DATA_TYPE) i*(j+3)) / nx;
+      }
+}
+
+#endif /* !_FDTD_2D_INIT_H */
@@ -11,7 +11,7 @@
 # define _GEMM_H
 
 /* Default to LARGE_DATASET. */
-# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(MEDIUM_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET)
+# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(MEDIUM_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET) && !defined(HUGE_DATASET)
 #  define LARGE_DATASET
 # endif
 
@@ -47,14 +47,43 @@
 #   define NK 2600
 #  endif
 
+#  ifdef HUGE_DATASET
+#   define NI 16000
+#   define NJ 18400
+#   define NK 20800
+#  endif
+
 
 #endif /* !(NI NJ NK) */
 
+/* Sizes read at run time, see POLYBENCH_DYNAMIC_SIZE. */
+# ifdef POLYBENCH_DYNAMIC_SIZES
+POLYBENCH_DYNAMIC_SIZE(NI)
+#  undef NI
+#  define NI polybench_size_NI
+POLYBENCH_DYNAMIC_SIZE(NJ)
+#  undef NJ
+#  define NJ polybench_size_NJ
+POLYBENCH_DYNAMIC_SIZE(NK)
+#  undef NK
+#  define NK polybench_size_NK
+# endif
+
 # define _PB_NI POLYBENCH_LOOP_BOUND(NI,ni)
 # define _PB_NJ POLYBENCH_LOOP_BOUND(NJ,nj)
 # define _PB_NK POLYBENCH_LOOP_BOUND(NK,nk)
 
 
+/* Weak scaling (run.sh -W): the work is cubic in these sizes. */
+# define POLYBENCH_WEAK_DIMS "NI NJ NK"
+# define POLYBENCH_WEAK_DEGREE 3
+
+/* Models of the kernel (cf. polybench.h): the traffic counts A, B
+   read once, C read and written once. */
+# define POLYBENCH_PROGRAM_FLOPS (1.0*NI*NJ + 3.0*NI*NJ*NK)
+# define POLYBENCH_PROGRAM_BYTES \
+  (sizeof(DATA_TYPE) * (1.0*NI*NK + 1.0*NK*NJ + 2.0*NI*NJ))
+
 /* Default data type */
 # if !defined(DATA_TYPE_IS_INT) && !defined(DATA_TYPE_IS_FLOAT) && !defined(DATA_TYPE_IS_DOUBLE)
 #  define DATA_TYPE_IS_DOUBLE
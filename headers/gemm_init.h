@@ -0,0 +1,64 @@
+/**
+ * gemm_init.h: array initialization of gemm, shared by the original,
+ * fission and alt versions so that they all run on the same data.
+ */
+#ifndef _GEMM_INIT_H
+# define _GEMM_INIT_H
+
+/* Array initialization, parallel over the rows. Along a row, each
+   remainder grows by i (modulo the divisor) at each step: it is carried
+   rather than recomputed, which keeps the integer division out of the
+   inner loops. The values are the same as computed directly. */
+static
+void init_array(INDEX_TYPE ni, INDEX_TYPE nj, INDEX_TYPE nk,
+		DATA_TYPE *alpha,
+		DATA_TYPE *beta,
+		DATA_TYPE POLYBENCH_2D(C,NI,NJ,ni,nj),
+		DATA_TYPE POLYBENCH_2D(A,NI,NK,ni,nk),
+		DATA_TYPE POLYBENCH_2D(B,NK,NJ,nk,nj))
+{
+  INDEX_TYPE i, j, v, s;
+
+  *alpha = 1.5;
+  *beta = 1.2;
+  /* C[i][j] = ((i*j+1) % ni) / ni */
+#pragma omp parallel for private (j, v, s) schedule (static)
+  for (i = 0; i < ni; i++)
+    {
+      v = 1 % ni;
+      s = i % ni;
+      for (j = 0; j < nj; j++)
+	{
+	  C[i][j] = (DATA_TYPE) v / ni;
+	  v += s;
+	  v -= v >= ni ? ni : 0;
+	}
+    }
+  /* A[i][j] = (i*(j+1) % nk) / nk */
+#pragma omp parallel for private (j, v, s) schedule (static)
+  for (i = 0; i < ni; i++)
+    {
+      s = v = i % nk;
+      for (j = 0; j < nk; j++)
+	{
+	  A[i][j] = (DATA_TYPE) v / nk;
+	  v += s;
+	  v -= v >= nk ? nk : 0;
+	}
+    }
+  /* B[i][j] = (i*(j+2) % nj) / nj */
+#pragma omp parallel for private (j, v, s) schedule (static)
+  for (i = 0; i < nk; i++)
+    {
+      v = i*2 % nj;
+      s = i % nj;
+      for (j = 0; j < nj; j++)
+	{
+	  B[i][j] = (DATA_TYPE) v / nj;
+	  v += s;
+	  v -= v >= nj ? nj : 0;
+	}
+    }
+}
+
+#endif /* !_GEMM_INIT_H */
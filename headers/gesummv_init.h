@@ -0,0 +1,50 @@
+/**
+ * gesummv_init.h: array initialization of gesummv, shared by the
+ * original, fission and alt versions so that they all run on the same
+ * data.
+ */
+#ifndef _GESUMMV_INIT_H
+# define _GESUMMV_INIT_H
+
+/* Array initialization, parallel over the rows. Along a row, the
+   remainders of i*j+1 and i*j+2 by n grow by i at each step: they are
+   carried rather than recomputed, which keeps the integer division out
+   of the inner loop. The values are the same as computed directly.
+   The outputs tmp and y are zeroed with the rows, so that with the
+   local NUMA policy they are first touched along the kernel's loop;
+   x, read along the columns by every row, is shared. */
+static
+void init_array(INDEX_TYPE n,
+		DATA_TYPE *alpha,
+		DATA_TYPE *beta,
+		DATA_TYPE POLYBENCH_2D(A,N,N,n,n),
+		DATA_TYPE POLYBENCH_2D(B,N,N,n,n),
+		DATA_TYPE POLYBENCH_1D(tmp,N,n),
+		DATA_TYPE POLYBENCH_1D(x,N,n),
+		DATA_TYPE POLYBENCH_1D(y,N,n))
+{
+  INDEX_TYPE i, j, va, vb, s;
+
+  *alpha = 1.5;
+  *beta = 1.2;
+#pragma omp parallel for private (j, va, vb, s) schedule (static)
+  for (i = 0; i < n; i++)
+    {
+      x[i] = (DATA_TYPE)( i % n) / n;
+      tmp[i] = 0;
+      y[i] = 0;
+      va = 1 % n;
+      vb = 2 % n;
+      s = i % n;
+      for (j = 0; j < n; j++) {
+	A[i][j] = (DATA_TYPE) va / n;
+	B[i][j] = (DATA_TYPE) vb / n;
+	va += s;
+	va -= va >= n ? n : 0;
+	vb += s;
+	vb -= vb >= n ? n : 0;
+      }
+    }
+}
+
+#endif /* !_GESUMMV_INIT_H */
@@ -11,7 +11,7 @@
 # define _MVT_H
 
 /* Default to LARGE_DATASET. */
-# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(MEDIUM_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET)
+# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(MEDIUM_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET) && !defined(HUGE_DATASET)
 #  define LARGE_DATASET
 # endif
 
@@ -37,12 +37,32 @@
 #   define N 4000
 #  endif
 
+#  ifdef HUGE_DATASET
+#   define N 64000
+#  endif
+
 
 #endif /* !(N) */
 
+/* Sizes read at run time, see POLYBENCH_DYNAMIC_SIZE. */
+# ifdef POLYBENCH_DYNAMIC_SIZES
+POLYBENCH_DYNAMIC_SIZE(N)
+#  undef N
+#  define N polybench_size_N
+# endif
+
 # define _PB_N POLYBENCH_LOOP_BOUND(N,n)
 
 
+/* Weak scaling (run.sh -W): the work is quadratic in N. */
+# define POLYBENCH_WEAK_DIMS "N"
+# define POLYBENCH_WEAK_DEGREE 2
+
+/* Models of the kernel (cf. polybench.h): the traffic counts A read
+   by rows then by columns, x1, x2 read and written, y_1, y_2 read. */
+# define POLYBENCH_PROGRAM_FLOPS (4.0*N*N)
+# define POLYBENCH_PROGRAM_BYTES (sizeof(DATA_TYPE) * (2.0*N*N + 6.0*N))
+
 /* Default data type */
 # if !defined(DATA_TYPE_IS_INT) && !defined(DATA_TYPE_IS_FLOAT) && !defined(DATA_TYPE_IS_DOUBLE)
 #  define DATA_TYPE_IS_DOUBLE
@@ -0,0 +1,44 @@
+/**
+ * mvt_init.h: array initialization of mvt, shared by the original,
+ * fission and alt versions so that they all run on the same data.
+ */
+#ifndef _MVT_INIT_H
+# define _MVT_INIT_H
+
+/* Array initialization, parallel over the rows. Along a row, the
+   remainder of i*j by n grows by i at each step: it is carried rather
+   than recomputed, which keeps the integer division out of the inner
+   loop. The values are the same as computed directly.
+   With the local NUMA policy, the vectors are first touched by the
+   thread of their row, as the kernel's x1 and x2 loops split them; A
+   is placed by rows, as the x1 loop reads it (the x2 loop reads it by
+   columns, and cannot also be local). */
+static
+void init_array(INDEX_TYPE n,
+		DATA_TYPE POLYBENCH_1D(x1,N,n),
+		DATA_TYPE POLYBENCH_1D(x2,N,n),
+		DATA_TYPE POLYBENCH_1D(y_1,N,n),
+		DATA_TYPE POLYBENCH_1D(y_2,N,n),
+		DATA_TYPE POLYBENCH_2D(A,N,N,n,n))
+{
+  INDEX_TYPE i, j, v, s;
+
+#pragma omp parallel for private (j, v, s) schedule (static)
+  for (i = 0; i < n; i++)
+    {
+      x1[i] = (DATA_TYPE) (i % n) / n;
+      x2[i] = (DATA_TYPE) ((i + 1) % n) / n;
+      y_1[i] = (DATA_TYPE) ((i + 3) % n) / n;
+      y_2[i] = (DATA_TYPE) ((i + 4) % n) / n;
+      v = 0;
+      s = i % n;
+      for (j = 0; j < n; j++)
+	{
+	  A[i][j] = (DATA_TYPE) v / n;
+	  v += s;
+	  v -= v >= n ? n : 0;
+	}
+    }
+}
+
+#endif /* !_MVT_INIT_H */
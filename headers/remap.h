@@ -2,7 +2,7 @@
 # define _REMAP_H
 
 /* Default to LARGE_DATASET. */
-# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(MEDIUM_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET)
+# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(MEDIUM_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET) && !defined(HUGE_DATASET)
 #  define LARGE_DATASET
 #  define LARGE_DATASET
 # endif
@@ -29,10 +29,32 @@
 #   define LX 52
 #  endif
 
+#  ifdef HUGE_DATASET
+#   define LX 104
+#  endif
+
 #endif /* !(LX) */
 
+/* Sizes read at run time, see POLYBENCH_DYNAMIC_SIZE. */
+# ifdef POLYBENCH_DYNAMIC_SIZES
+POLYBENCH_DYNAMIC_SIZE(LX)
+#  undef LX
+#  define LX polybench_size_LX
+# endif
+
 # define _PB_LX POLYBENCH_LOOP_BOUND(LX,lx)
 
+/* Weak scaling (run.sh -W): the work is quartic in LX. */
+# define POLYBENCH_WEAK_DIMS "LX"
+# define POLYBENCH_WEAK_DEGREE 4
+
+/* Models of the kernel (cf. polybench.h): the traffic counts X read,
+   Y, YONE (2), YTWO (4), Y1 (7) read and written once, the four LX*LX
+   matrices read. */
+# define POLYBENCH_PROGRAM_FLOPS (28.0*LX*LX*LX*LX)
+# define POLYBENCH_PROGRAM_BYTES \
+  (sizeof(DATA_TYPE) * (29.0*LX*LX*LX + 4.0*LX*LX))
+
 /* Default data type */
 # if !defined(DATA_TYPE_IS_INT) && !defined(DATA_TYPE_IS_FLOAT) && !defined(DATA_TYPE_IS_DOUBLE)
 #  define DATA_TYPE_IS_DOUBLE
@@ -0,0 +1,92 @@
+/**
+ * remap_init.h: array initialization of remap, shared by the original,
+ * fission and alt versions so that they all run on the same data.
+ */
+#ifndef _REMAP_INIT_H
+# define _REMAP_INIT_H
+
+/* Array initialization. The interpolation matrices are small, and
+   filled serially; the fields are filled in parallel. */
+static
+void init_array(INDEX_TYPE lx,
+        DATA_TYPE POLYBENCH_4D(YONE,  YONE_SZ,LX,LX,LX,YONE_SZ,lx,lx,lx),
+        DATA_TYPE POLYBENCH_4D(YTWO,  YTWO_SZ,LX,LX,LX,YTWO_SZ,lx,lx,lx),
+        DATA_TYPE POLYBENCH_3D(X,     LX,LX,LX,lx,lx,lx),
+        DATA_TYPE POLYBENCH_3D(Y,     LX,LX,LX,lx,lx,lx),
+        DATA_TYPE POLYBENCH_2D(ixmc1, LX,LX,lx,lx),
+        DATA_TYPE POLYBENCH_2D(ixmc2, LX,LX,lx,lx),
+        DATA_TYPE POLYBENCH_2D(ixtmc1,LX,LX,lx,lx),
+        DATA_TYPE POLYBENCH_2D(ixtmc2,LX,LX,lx,lx))
+{
+    INDEX_TYPE i, j, k, h;
+
+    for (i = 0; i < lx; i++)
+        ixtmc1[0][i] = ixtmc1[lx-1][i] = 0.0;
+    ixtmc1[0][0] = 1.0;
+    ixtmc1[lx-1][lx/2] = 1.0;
+
+    for(i = 1; i < ((lx-2)/3); i += 3){
+        for(j = 0; j < lx/5; j += 5){
+            ixtmc1[1+i][(j+0) % lx] = j + i *  0.3385078435248143;
+            ixtmc1[1+i][(j+1) % lx] = j + i *  0.7898516348912331;
+            ixtmc1[1+i][(j+2) % lx] = j + i * -0.1884018684471238;
+            ixtmc1[1+i][(j+3) % lx] = j + i *  9.202967302175333e-02;
+            ixtmc1[1+i][(j+4) % lx] = j + i * -3.198728299067715e-02;
+        }
+        for(j = 0; j < lx/5; j += 5){
+            ixtmc1[2+i][(j+0) % lx] = j + i * -0.1171875;
+            ixtmc1[2+i][(j+1) % lx] = j + i *  0.8840317166357952;
+            ixtmc1[2+i][(j+2) % lx] = j + i *  0.3125;
+            ixtmc1[2+i][(j+3) % lx] = j + i * -0.118406716635795;
+            ixtmc1[2+i][(j+4) % lx] = j + i *  0.0390625;
+        }
+        for(j = 0; j < lx/5; j += 5){
+            ixtmc1[3+i][(j+0) % lx] = j + i * -7.065070066767144e-02;
+            ixtmc1[3+i][(j+1) % lx] = j + i *  0.2829703269782467;
+            ixtmc1[3+i][(j+2) % lx] = j + i *  0.902687582732838;
+            ixtmc1[3+i][(j+3) % lx] = j + i * -0.1648516348912333;
+            ixtmc1[3+i][(j+4) % lx] = j + i *  4.984442584781999e-02;
+        }
+    }
+    for (j = 0; j < lx; j++)
+        for (i = 0; i < lx; i++)
+            ixtmc2[j][i] = ixtmc1[lx - 1 - j][lx - 1 - i];
+
+    for (i = 0; i < lx; i++)
+        for (j = 0; j < lx; j++)
+            ixmc1[j][i] = ixtmc1[i][j];
+
+    for (i = 0; i < lx; i++)
+        for (j = 0; j < lx; j++)
+            ixmc2[j][i] = ixtmc2[i][j];
+
+#pragma omp parallel for private (k) collapse (2) schedule (static)
+    for (i = 0; i < lx; i++)
+        for (j = 0; j < lx; j++)
+            for (k = 0; k < lx; k++)
+                X[i][j][k] = sin(i+j+k);
+
+#pragma omp parallel for private (k) collapse (2) schedule (static)
+    for (i = 0; i < lx; i++)
+        for (j = 0; j < lx; j++)
+            for (k = 0; k < lx; k++)
+                Y[i][j][k] = cos(i+j+k);
+
+#pragma omp parallel for private (k, h) collapse (2) schedule (static)
+    for (i = 0; i < YONE_SZ; i++)
+        for (j = 0; j < lx; j++)
+            for (k = 0; k < lx; k++)
+#pragma omp simd
+                for (h = 0; h < lx; h++)
+                    YONE[i][j][k][h] = 0;
+
+#pragma omp parallel for private (k, h) collapse (2) schedule (static)
+    for (i = 0; i < YTWO_SZ; i++)
+        for (j = 0; j < lx; j++)
+            for (k = 0; k < lx; k++)
+#pragma omp simd
+                for (h = 0; h < lx; h++)
+                    YTWO[i][j][k][h] = 0;
+}
+
+#endif /* !_REMAP_INIT_H */
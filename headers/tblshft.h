@@ -2,7 +2,7 @@
 # define _TBLSHFT_H
 
 /* Default to LARGE_DATASET. */
-# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(MEDIUM_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET)
+# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(MEDIUM_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET) && !defined(HUGE_DATASET)
 #  define LARGE_DATASET
 #  define LARGE_DATASET
 # endif
@@ -39,12 +39,43 @@
 #   define TSZ 2049
 #  endif
 
+#  ifdef HUGE_DATASET
+#   define F8SZ 16777216    /* 2^24 */
+#   define F14SZ 2147483648 /* 2^31 */
+#   define TSZ 2049
+#  endif
+
 
 #endif /* !(F8SZ F14SZ TSZ) */
 
+/* Sizes read at run time, see POLYBENCH_DYNAMIC_SIZE. */
+# ifdef POLYBENCH_DYNAMIC_SIZES
+POLYBENCH_DYNAMIC_SIZE(F8SZ)
+#  undef F8SZ
+#  define F8SZ polybench_size_F8SZ
+POLYBENCH_DYNAMIC_SIZE(F14SZ)
+#  undef F14SZ
+#  define F14SZ polybench_size_F14SZ
+POLYBENCH_DYNAMIC_SIZE(TSZ)
+#  undef TSZ
+#  define TSZ polybench_size_TSZ
+# endif
+
 # define _PB_F8 POLYBENCH_LOOP_BOUND(F8SZ,f8sz)
 # define _PB_F14 POLYBENCH_LOOP_BOUND(F14SZ,f14sz)
 
+/* Weak scaling (run.sh -W): the work is linear in these sizes. The
+   table, TSZ, is kept. */
+# define POLYBENCH_WEAK_DIMS "F8SZ F14SZ"
+# define POLYBENCH_WEAK_DEGREE 1
+
+/* Models of the kernel (cf. polybench.h): the traffic counts about
+   one test of 4 flops per entry and per table step, TLF read twice,
+   F14 and F8 written. */
+# define POLYBENCH_PROGRAM_FLOPS (4.0*(F14SZ + F8SZ + 2.0*TSZ))
+# define POLYBENCH_PROGRAM_BYTES \
+  (sizeof(DATA_TYPE) * (1.0*F14SZ + 1.0*F8SZ + 2.0*TSZ))
+
 /* Default data type */
 # if !defined(DATA_TYPE_IS_INT) && !defined(DATA_TYPE_IS_FLOAT) && !defined(DATA_TYPE_IS_DOUBLE)
 #  define DATA_TYPE_IS_DOUBLE
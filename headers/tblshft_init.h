@@ -0,0 +1,41 @@
+/**
+ * tblshft_init.h: array initialization of tblshft, shared by the
+ * original, fission and alt versions so that they all run on the same
+ * data.
+ */
+#ifndef _TBLSHFT_INIT_H
+# define _TBLSHFT_INIT_H
+
+#define ONE      1250       /* token value of 1.0 exactly */
+#define RATIO	 1.004		/* nominal ratio for log part */
+
+/* Array initialization. The table is small (TSZ entries), and filled
+   serially. */
+static
+void init_array(INDEX_TYPE tsz,
+    DATA_TYPE POLYBENCH_1D(TLF,TSZ,tsz))
+{
+
+    INDEX_TYPE i, j, nlin;
+    double b, c, linstep, v;
+    INDEX_TYPE TSIZE = tsz - 1;
+
+    j = 0;
+    c = log(RATIO);
+    nlin = 1. / c;
+    c = 1. / nlin;
+    b = exp(-c * ONE);
+    linstep = b * c * exp(1.);
+
+    for (i = 0; i < nlin; i++) {
+        v = i * linstep;
+        TLF[j++] = (DATA_TYPE) v;
+    }
+
+    for (i = nlin; i < TSIZE; i++)
+        TLF[j++] = b * exp(c * i);
+
+    TLF[TSIZE] = TLF[TSIZE - 1];
+}
+
+#endif /* !_TBLSHFT_INIT_H */
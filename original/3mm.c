@@ -21,38 +21,17 @@
 #include <3mm.h>
 
 
-/* Array initialization. */
-static
-void init_array(int ni, int nj, int nk, int nl, int nm,
-        DATA_TYPE POLYBENCH_2D(A,NI,NK,ni,nk),
-        DATA_TYPE POLYBENCH_2D(B,NK,NJ,nk,nj),
-        DATA_TYPE POLYBENCH_2D(C,NJ,NM,nj,nm),
-        DATA_TYPE POLYBENCH_2D(D,NM,NL,nm,nl))
-{
-int i, j;
-
-for (i = 0; i < ni; i++)
-for (j = 0; j < nk; j++)
-A[i][j] = (DATA_TYPE) ((i*j+1) % ni) / (5*ni);
-for (i = 0; i < nk; i++)
-for (j = 0; j < nj; j++)
-B[i][j] = (DATA_TYPE) ((i*(j+1)+2) % nj) / (5*nj);
-for (i = 0; i < nj; i++)
-for (j = 0; j < nm; j++)
-C[i][j] = (DATA_TYPE) (i*(j+3) % nl) / (5*nl);
-for (i = 0; i < nm; i++)
-for (j = 0; j < nl; j++)
-D[i][j] = (DATA_TYPE) ((i*(j+2)+2) % nk) / (5*nk);
-}
+/* Include array initialization, shared by all versions. */
+#include <3mm_init.h>
 
 
 /* DCE code. Must scan the entire live-out data.
    Can be used also to check the correctness of the output. */
 static
-void print_array(int ni, int nl,
+void print_array(INDEX_TYPE ni, INDEX_TYPE nl,
                  DATA_TYPE POLYBENCH_2D(G,NI,NL,ni,nl))
 {
-int i, j;
+INDEX_TYPE i, j;
 
 POLYBENCH_DUMP_START;
 POLYBENCH_DUMP_BEGIN("G");
@@ -69,7 +48,7 @@ POLYBENCH_DUMP_FINISH;
 /* Main computational kernel. The whole function will be timed,
    including the call and return. */
 static
-void kernel_3mm(int ni, int nj, int nk, int nl, int nm,
+void kernel_3mm(INDEX_TYPE ni, INDEX_TYPE nj, INDEX_TYPE nk, INDEX_TYPE nl, INDEX_TYPE nm,
         DATA_TYPE POLYBENCH_2D(E,NI,NJ,ni,nj),
         DATA_TYPE POLYBENCH_2D(A,NI,NK,ni,nk),
         DATA_TYPE POLYBENCH_2D(B,NK,NJ,nk,nj),
@@ -78,7 +57,7 @@ void kernel_3mm(int ni, int nj, int nk, int nl, int nm,
         DATA_TYPE POLYBENCH_2D(D,NM,NL,nm,nl),
         DATA_TYPE POLYBENCH_2D(G,NI,NL,ni,nl))
 {
-int i, j, k;
+INDEX_TYPE i, j, k;
 
 #pragma scop
 
@@ -117,11 +96,11 @@ for (i = 0; i < _PB_NI; i++)
 int main(int argc, char** argv)
 {
     /* Retrieve problem size. */
-    int ni = NI;
-    int nj = NJ;
-    int nk = NK;
-    int nl = NL;
-    int nm = NM;
+    INDEX_TYPE ni = NI;
+    INDEX_TYPE nj = NJ;
+    INDEX_TYPE nk = NK;
+    INDEX_TYPE nl = NL;
+    INDEX_TYPE nm = NM;
 
     /* Variable declaration/allocation. */
     POLYBENCH_2D_ARRAY_DECL(E, DATA_TYPE, NI, NJ, ni, nj);
@@ -133,11 +112,15 @@ int main(int argc, char** argv)
     POLYBENCH_2D_ARRAY_DECL(G, DATA_TYPE, NI, NL, ni, nl);
 
     /* Initialize array(s). */
-    init_array (ni, nj, nk, nl, nm,
+    polybench_cached_init (init_array (ni, nj, nk, nl, nm,
                 POLYBENCH_ARRAY(A),
                 POLYBENCH_ARRAY(B),
                 POLYBENCH_ARRAY(C),
-                POLYBENCH_ARRAY(D));
+                POLYBENCH_ARRAY(D)));
+
+    /* Work and memory traffic of the kernel, see the header. */
+    polybench_set_program_flops (POLYBENCH_PROGRAM_FLOPS);
+    polybench_set_program_bytes (POLYBENCH_PROGRAM_BYTES);
 
     /* Start timer. */
     polybench_start_instruments;
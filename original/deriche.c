@@ -21,31 +21,18 @@
 #include <deriche.h>
 
 
-/* Array initialization. */
-static
-void init_array (int w, int h, DATA_TYPE* alpha,
-        DATA_TYPE POLYBENCH_2D(imgIn,W,H,w,h),
-        DATA_TYPE POLYBENCH_2D(imgOut,W,H,w,h))
-{
-    int i, j;
-
-    *alpha=0.25; //parameter of the filter
-
-    //input should be between 0 and 1 (grayscale image pixel)
-    for (i = 0; i < w; i++)
-    for (j = 0; j < h; j++)
-        imgIn[i][j] = (DATA_TYPE) ((313*i+991*j)%65536) / 65535.0f;
-}
+/* Include array initialization, shared by all versions. */
+#include <deriche_init.h>
 
 
 /* DCE code. Must scan the entire live-out data.
    Can be used also to check the correctness of the output. */
 static
-void print_array(int w, int h,
+void print_array(INDEX_TYPE w, INDEX_TYPE h,
                  DATA_TYPE POLYBENCH_2D(imgOut,W,H,w,h))
 
 {
-    int i, j;
+    INDEX_TYPE i, j;
 
     POLYBENCH_DUMP_START;
     POLYBENCH_DUMP_BEGIN("imgOut");
@@ -64,13 +51,13 @@ void print_array(int w, int h,
    including the call and return. */
 /* Original code provided by Gael Deest */
 static
-void kernel_deriche(int w, int h, DATA_TYPE alpha,
+void kernel_deriche(INDEX_TYPE w, INDEX_TYPE h, DATA_TYPE alpha,
         DATA_TYPE POLYBENCH_2D(imgIn, W, H, w, h),
         DATA_TYPE POLYBENCH_2D(imgOut, W, H, w, h),
         DATA_TYPE POLYBENCH_2D(y1, W, H, w, h),
         DATA_TYPE POLYBENCH_2D(y2, W, H, w, h))
 {
-int i,j;
+INDEX_TYPE i,j;
 DATA_TYPE xm1, tm1, ym1, ym2;
 DATA_TYPE xp1, xp2;
 DATA_TYPE tp1, tp2;
@@ -160,8 +147,8 @@ for (i=0; i<_PB_W; i++)
 int main(int argc, char** argv)
 {
     /* Retrieve problem size. */
-    int w = W;
-    int h = H;
+    INDEX_TYPE w = W;
+    INDEX_TYPE h = H;
 
     /* Variable declaration/allocation. */
     DATA_TYPE alpha;
@@ -172,7 +159,12 @@ int main(int argc, char** argv)
 
 
     /* Initialize array(s). */
-    init_array (w, h, &alpha, POLYBENCH_ARRAY(imgIn), POLYBENCH_ARRAY(imgOut));
+    polybench_dataset_scalar (&alpha, sizeof(alpha));
+    polybench_cached_init (init_array (w, h, &alpha, POLYBENCH_ARRAY(imgIn), POLYBENCH_ARRAY(imgOut)));
+
+    /* Work and memory traffic of the kernel, see the header. */
+    polybench_set_program_flops (POLYBENCH_PROGRAM_FLOPS);
+    polybench_set_program_bytes (POLYBENCH_PROGRAM_BYTES);
 
     /* Start timer. */
     polybench_start_instruments;
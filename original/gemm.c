@@ -21,38 +21,17 @@
 #include "gemm.h"
 
 
-/* Array initialization. */
-static
-void init_array(int ni, int nj, int nk,
-		DATA_TYPE *alpha,
-		DATA_TYPE *beta,
-		DATA_TYPE POLYBENCH_2D(C,NI,NJ,ni,nj),
-		DATA_TYPE POLYBENCH_2D(A,NI,NK,ni,nk),
-		DATA_TYPE POLYBENCH_2D(B,NK,NJ,nk,nj))
-{
-  int i, j;
-
-  *alpha = 1.5;
-  *beta = 1.2;
-  for (i = 0; i < ni; i++)
-    for (j = 0; j < nj; j++)
-      C[i][j] = (DATA_TYPE) ((i*j+1) % ni) / ni;
-  for (i = 0; i < ni; i++)
-    for (j = 0; j < nk; j++)
-      A[i][j] = (DATA_TYPE) (i*(j+1) % nk) / nk;
-  for (i = 0; i < nk; i++)
-    for (j = 0; j < nj; j++)
-      B[i][j] = (DATA_TYPE) (i*(j+2) % nj) / nj;
-}
+/* Include array initialization, shared by all versions. */
+#include <gemm_init.h>
 
 
 /* DCE code. Must scan the entire live-out data.
    Can be used also to check the correctness of the output. */
 static
-void print_array(int ni, int nj,
+void print_array(INDEX_TYPE ni, INDEX_TYPE nj,
 		 DATA_TYPE POLYBENCH_2D(C,NI,NJ,ni,nj))
 {
-  int i, j;
+  INDEX_TYPE i, j;
 
   POLYBENCH_DUMP_START;
   POLYBENCH_DUMP_BEGIN("C");
@@ -69,14 +48,14 @@ void print_array(int ni, int nj,
 /* Main computational kernel. The whole function will be timed,
    including the call and return. */
 static
-void kernel_gemm(int ni, int nj, int nk,
+void kernel_gemm(INDEX_TYPE ni, INDEX_TYPE nj, INDEX_TYPE nk,
 		 DATA_TYPE alpha,
 		 DATA_TYPE beta,
 		 DATA_TYPE POLYBENCH_2D(C,NI,NJ,ni,nj),
 		 DATA_TYPE POLYBENCH_2D(A,NI,NK,ni,nk),
 		 DATA_TYPE POLYBENCH_2D(B,NK,NJ,nk,nj))
 {
-  int i, j, k;
+  INDEX_TYPE i, j, k;
 
 //BLAS PARAMS
 //TRANSA = 'N'
@@ -104,9 +83,9 @@ void kernel_gemm(int ni, int nj, int nk,
 int main(int argc, char** argv)
 {
   /* Retrieve problem size. */
-  int ni = NI;
-  int nj = NJ;
-  int nk = NK;
+  INDEX_TYPE ni = NI;
+  INDEX_TYPE nj = NJ;
+  INDEX_TYPE nk = NK;
 
   /* Variable declaration/allocation. */
   DATA_TYPE alpha;
@@ -116,10 +95,16 @@ int main(int argc, char** argv)
   POLYBENCH_2D_ARRAY_DECL(B,DATA_TYPE,NK,NJ,nk,nj);
 
   /* Initialize array(s). */
-  init_array (ni, nj, nk, &alpha, &beta,
+  polybench_dataset_scalar (&alpha, sizeof(alpha));
+  polybench_dataset_scalar (&beta, sizeof(beta));
+  polybench_cached_init (init_array (ni, nj, nk, &alpha, &beta,
 	      POLYBENCH_ARRAY(C),
 	      POLYBENCH_ARRAY(A),
-	      POLYBENCH_ARRAY(B));
+	      POLYBENCH_ARRAY(B)));
+
+  /* Work and memory traffic of the kernel, see the header. */
+  polybench_set_program_flops (POLYBENCH_PROGRAM_FLOPS);
+  polybench_set_program_bytes (POLYBENCH_PROGRAM_BYTES);
 
   /* Start timer. */
   polybench_start_instruments;
@@ -21,38 +21,18 @@
 #include <gesummv.h>
 
 
-/* Array initialization. */
-static
-void init_array(int n,
-		DATA_TYPE *alpha,
-		DATA_TYPE *beta,
-		DATA_TYPE POLYBENCH_2D(A,N,N,n,n),
-		DATA_TYPE POLYBENCH_2D(B,N,N,n,n),
-		DATA_TYPE POLYBENCH_1D(x,N,n))
-{
-  int i, j;
-
-  *alpha = 1.5;
-  *beta = 1.2;
-  for (i = 0; i < n; i++)
-    {
-      x[i] = (DATA_TYPE)( i % n) / n;
-      for (j = 0; j < n; j++) {
-	A[i][j] = (DATA_TYPE) ((i*j+1) % n) / n;
-	B[i][j] = (DATA_TYPE) ((i*j+2) % n) / n;
-      }
-    }
-}
+/* Include array initialization, shared by all versions. */
+#include <gesummv_init.h>
 
 
 /* DCE code. Must scan the entire live-out data.
    Can be used also to check the correctness of the output. */
 static
-void print_array(int n,
+void print_array(INDEX_TYPE n,
 		 DATA_TYPE POLYBENCH_1D(y,N,n))
 
 {
-  int i;
+  INDEX_TYPE i;
 
   POLYBENCH_DUMP_START;
   POLYBENCH_DUMP_BEGIN("y");
@@ -68,7 +48,7 @@ void print_array(int n,
 /* Main computational kernel. The whole function will be timed,
    including the call and return. */
 static
-void kernel_gesummv(int n,
+void kernel_gesummv(INDEX_TYPE n,
 		    DATA_TYPE alpha,
 		    DATA_TYPE beta,
 		    DATA_TYPE POLYBENCH_2D(A,N,N,n,n),
@@ -77,7 +57,7 @@ void kernel_gesummv(int n,
 		    DATA_TYPE POLYBENCH_1D(x,N,n),
 		    DATA_TYPE POLYBENCH_1D(y,N,n))
 {
-  int i, j;
+  INDEX_TYPE i, j;
 
 #pragma scop
 
@@ -105,7 +85,7 @@ void kernel_gesummv(int n,
 int main(int argc, char** argv)
 {
   /* Retrieve problem size. */
-  int n = N;
+  INDEX_TYPE n = N;
 
   /* Variable declaration/allocation. */
   DATA_TYPE alpha;
@@ -118,10 +98,18 @@ int main(int argc, char** argv)
 
 
   /* Initialize array(s). */
-  init_array (n, &alpha, &beta,
+  polybench_dataset_scalar (&alpha, sizeof(alpha));
+  polybench_dataset_scalar (&beta, sizeof(beta));
+  polybench_cached_init (init_array (n, &alpha, &beta,
 	      POLYBENCH_ARRAY(A),
 	      POLYBENCH_ARRAY(B),
-	      POLYBENCH_ARRAY(x));
+	      POLYBENCH_ARRAY(tmp),
+	      POLYBENCH_ARRAY(x),
+	      POLYBENCH_ARRAY(y)));
+
+  /* Work and memory traffic of the kernel, see the header. */
+  polybench_set_program_flops (POLYBENCH_PROGRAM_FLOPS);
+  polybench_set_program_bytes (POLYBENCH_PROGRAM_BYTES);
 
   /* Start timer. */
   polybench_start_instruments;
@@ -31,90 +31,16 @@
 #define YTWO_SZ 4
 #define Y1_SIZE 7
 
-/* Array initialization. */
-static
-void init_array(int lx,
-        DATA_TYPE POLYBENCH_4D(YONE,  YONE_SZ,LX,LX,LX,YONE_SZ,lx,lx,lx),
-        DATA_TYPE POLYBENCH_4D(YTWO,  YTWO_SZ,LX,LX,LX,YTWO_SZ,lx,lx,lx),
-        DATA_TYPE POLYBENCH_3D(X,     LX,LX,LX,lx,lx,lx),
-        DATA_TYPE POLYBENCH_3D(Y,     LX,LX,LX,lx,lx,lx),
-        DATA_TYPE POLYBENCH_2D(ixmc1, LX,LX,lx,lx),
-        DATA_TYPE POLYBENCH_2D(ixmc2, LX,LX,lx,lx),
-        DATA_TYPE POLYBENCH_2D(ixtmc1,LX,LX,lx,lx),
-        DATA_TYPE POLYBENCH_2D(ixtmc2,LX,LX,lx,lx))
-{
-    int i, j, k, h;
-
-    for (i = 0; i < lx; i++)
-        ixtmc1[0][i] = ixtmc1[lx-1][i] = 0.0;
-    ixtmc1[0][0] = 1.0;
-    ixtmc1[lx-1][lx/2] = 1.0;
-
-    for(i = 1; i < ((lx-2)/3); i += 3){
-        for(j = 0; j < lx/5; j += 5){
-            ixtmc1[1+i][(j+0) % lx] = j + i *  0.3385078435248143;
-            ixtmc1[1+i][(j+1) % lx] = j + i *  0.7898516348912331;
-            ixtmc1[1+i][(j+2) % lx] = j + i * -0.1884018684471238;
-            ixtmc1[1+i][(j+3) % lx] = j + i *  9.202967302175333e-02;
-            ixtmc1[1+i][(j+4) % lx] = j + i * -3.198728299067715e-02;
-        }
-        for(j = 0; j < lx/5; j += 5){
-            ixtmc1[2+i][(j+0) % lx] = j + i * -0.1171875;
-            ixtmc1[2+i][(j+1) % lx] = j + i *  0.8840317166357952;
-            ixtmc1[2+i][(j+2) % lx] = j + i *  0.3125;
-            ixtmc1[2+i][(j+3) % lx] = j + i * -0.118406716635795;
-            ixtmc1[2+i][(j+4) % lx] = j + i *  0.0390625;
-        }
-        for(j = 0; j < lx/5; j += 5){
-            ixtmc1[3+i][(j+0) % lx] = j + i * -7.065070066767144e-02;
-            ixtmc1[3+i][(j+1) % lx] = j + i *  0.2829703269782467;
-            ixtmc1[3+i][(j+2) % lx] = j + i *  0.902687582732838;
-            ixtmc1[3+i][(j+3) % lx] = j + i * -0.1648516348912333;
-            ixtmc1[3+i][(j+4) % lx] = j + i *  4.984442584781999e-02;
-        }
-    }
-    for (j = 0; j < lx; j++)
-        for (i = 0; i < lx; i++)
-            ixtmc2[j][i] = ixtmc1[lx - 1 - j][lx - 1 - i];
-
-    for (i = 0; i < lx; i++)
-        for (j = 0; j < lx; j++)
-            ixmc1[j][i] = ixtmc1[i][j];
-
-    for (i = 0; i < lx; i++)
-        for (j = 0; j < lx; j++)
-            ixmc2[j][i] = ixtmc2[i][j];
-
-    for (i = 0; i < lx; i++)
-        for (j = 0; j < lx; j++)
-            for (k = 0; k < lx; k++)
-                X[i][j][k] = sin(i+j+k);
-
-    for (i = 0; i < lx; i++)
-        for (j = 0; j < lx; j++)
-            for (k = 0; k < lx; k++)
-                Y[i][j][k] = cos(i+j+k);
-
-    for (i = 0; i < YONE_SZ; i++)
-        for (j = 0; j < lx; j++)
-            for (k = 0; k < lx; k++)
-                for (h = 0; h < lx; h++)
-                    YONE[i][j][k][h] = 0;
-
-    for (i = 0; i < YTWO_SZ; i++)
-        for (j = 0; j < lx; j++)
-            for (k = 0; k < lx; k++)
-                for (h = 0; h < lx; h++)
-                    YTWO[i][j][k][h] = 0;
-}
+/* Include array initialization, shared by all versions. */
+#include <remap_init.h>
 
 
 /* DCE code. Must scan the entire live-out data.
    Can be used also to check the correctness of the output. */
 static
-void print_array(int lx, DATA_TYPE POLYBENCH_4D(Y1,Y1_SIZE,LX,LX,LX,Y1_SIZE,lx,lx,lx))
+void print_array(INDEX_TYPE lx, DATA_TYPE POLYBENCH_4D(Y1,Y1_SIZE,LX,LX,LX,Y1_SIZE,lx,lx,lx))
 {
-  int i, j, k, l;
+  INDEX_TYPE i, j, k, l;
 
   POLYBENCH_DUMP_START;
   POLYBENCH_DUMP_BEGIN("Y1");
@@ -133,7 +59,7 @@ void print_array(int lx, DATA_TYPE POLYBENCH_4D(Y1,Y1_SIZE,LX,LX,LX,Y1_SIZE,lx,l
 /* Main computational kernel. The whole function will be timed,
    including the call and return. */
 static
-void kernel_remap(int lx,
+void kernel_remap(INDEX_TYPE lx,
         DATA_TYPE POLYBENCH_4D(YONE,  YONE_SZ,LX,LX,LX,YONE_SZ,lx,lx,lx),
         DATA_TYPE POLYBENCH_4D(YTWO,  YTWO_SZ,LX,LX,LX,YTWO_SZ,lx,lx,lx),
         DATA_TYPE POLYBENCH_4D(Y1,    Y1_SIZE,LX,LX,LX,Y1_SIZE,lx,lx,lx),
@@ -144,7 +70,7 @@ void kernel_remap(int lx,
         DATA_TYPE POLYBENCH_2D(ixtmc1,LX,LX,lx,lx),
         DATA_TYPE POLYBENCH_2D(ixtmc2,LX,LX,lx,lx))
 {
-   int i, iz, ii, jj, kk;;
+   INDEX_TYPE i, iz, ii, jj, kk;;
 
 #pragma scop
 
@@ -218,7 +144,7 @@ void kernel_remap(int lx,
 int main(int argc, char** argv)
 {
   /* Retrieve problem size. */
-  int lx = LX;
+  INDEX_TYPE lx = LX;
 
   /* Variable declaration/allocation. */
   POLYBENCH_4D_ARRAY_DECL(YONE,DATA_TYPE,YONE_SZ,LX,LX,LX,YONE_SZ,lx,lx,lx);
@@ -232,7 +158,7 @@ int main(int argc, char** argv)
   POLYBENCH_2D_ARRAY_DECL(ixtmc2,DATA_TYPE,LX,LX,lx,lx);
 
   /* Initialize array(s). */
-  init_array (lx,
+  polybench_cached_init (init_array (lx,
               POLYBENCH_ARRAY(YONE),
               POLYBENCH_ARRAY(YTWO),
               POLYBENCH_ARRAY(X),
@@ -240,7 +166,11 @@ int main(int argc, char** argv)
               POLYBENCH_ARRAY(ixmc1),
               POLYBENCH_ARRAY(ixmc2),
               POLYBENCH_ARRAY(ixtmc1),
-              POLYBENCH_ARRAY(ixtmc2));
+              POLYBENCH_ARRAY(ixtmc2)));
+
+  /* Work and memory traffic of the kernel, see the header. */
+  polybench_set_program_flops (POLYBENCH_PROGRAM_FLOPS);
+  polybench_set_program_bytes (POLYBENCH_PROGRAM_BYTES);
 
   /* Start timer. */
   polybench_start_instruments;
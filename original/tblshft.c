@@ -25,46 +25,18 @@
 /* Default data type is double, default size is N=1024. */
 #include <tblshft.h>
 
-#define ONE      1250       /* token value of 1.0 exactly */
-#define RATIO	 1.004		/* nominal ratio for log part */
-
-/* Array initialization. */
-static
-void init_array(int tsz,
-    DATA_TYPE POLYBENCH_1D(TLF,TSZ,tsz))
-{
-
-    int i, j, nlin;
-    double b, c, linstep, v;
-    int TSIZE = tsz - 1;
-
-    j = 0;
-    c = log(RATIO);
-    nlin = 1. / c;
-    c = 1. / nlin;
-    b = exp(-c * ONE);
-    linstep = b * c * exp(1.);
-
-    for (i = 0; i < nlin; i++) {
-        v = i * linstep;
-        TLF[j++] = (DATA_TYPE) v;
-    }
-
-    for (i = nlin; i < TSIZE; i++)
-        TLF[j++] = b * exp(c * i);
-
-    TLF[TSIZE] = TLF[TSIZE - 1];
-}
+/* Include array initialization, shared by all versions. */
+#include <tblshft_init.h>
 
 
 /* DCE code. Must scan the entire live-out data.
    Can be used also to check the correctness of the output. */
 static
-void print_array(int f8sz, int f14sz,
+void print_array(INDEX_TYPE f8sz, INDEX_TYPE f14sz,
     DATA_TYPE POLYBENCH_1D(F8,F8SZ,f8sz),
     DATA_TYPE POLYBENCH_1D(F14,F14SZ,f14sz))
 {
-  int i, j;
+  INDEX_TYPE i, j;
 
   POLYBENCH_DUMP_START;
   POLYBENCH_DUMP_BEGIN("F8");
@@ -86,12 +58,12 @@ void print_array(int f8sz, int f14sz,
 /* Main computational kernel. The whole function will be timed,
    including the call and return. */
 static
-void kernel_tblshft(int f8sz, int f14sz, int tsz,
+void kernel_tblshft(INDEX_TYPE f8sz, INDEX_TYPE f14sz, INDEX_TYPE tsz,
         DATA_TYPE POLYBENCH_1D(F8,F8SZ,f8sz),
         DATA_TYPE POLYBENCH_1D(F14,F14SZ,f14sz),
         DATA_TYPE POLYBENCH_1D(TLF,TSZ,tsz))
 {
-  int i, j;
+  INDEX_TYPE i, j;
   DATA_TYPE F14SZM1 = (DATA_TYPE)(f14sz - 1);
   DATA_TYPE F8SZM1 = (DATA_TYPE)(f8sz-1);
 
@@ -120,9 +92,9 @@ int main(int argc, char** argv)
 {
 
   /* Retrieve problem size. */
-  int f8sz = F8SZ;
-  int f14sz = F14SZ;
-  int tsz = TSZ;
+  INDEX_TYPE f8sz = F8SZ;
+  INDEX_TYPE f14sz = F14SZ;
+  INDEX_TYPE tsz = TSZ;
 
   /* Variable declaration/allocation. */
   POLYBENCH_1D_ARRAY_DECL(F8,DATA_TYPE,F8SZ,f8sz);
@@ -130,7 +102,11 @@ int main(int argc, char** argv)
   POLYBENCH_1D_ARRAY_DECL(TLF,DATA_TYPE,TSZ,tsz);
 
   /* Initialize array(s). */
-  init_array (tsz, POLYBENCH_ARRAY(TLF));
+  polybench_cached_init (init_array (tsz, POLYBENCH_ARRAY(TLF)));
+
+  /* Work and memory traffic of the kernel, see the header. */
+  polybench_set_program_flops (POLYBENCH_PROGRAM_FLOPS);
+  polybench_set_program_bytes (POLYBENCH_PROGRAM_BYTES);
 
   /* Start timer. */
   polybench_start_instruments;
@@ -31,9 +31,20 @@ warnings.filterwarnings("ignore")
 # where to look for timing results
 RESULTS_DIR = './eval/results'
 
+# results in run order, see utilities/schedule.sh
+SCHEDULE_DIR = './eval/schedule'
+
+# machine ceilings for the roofline report, see utilities/roofline.c
+ROOFLINE_FILE = './eval/roofline.txt'
+
 # custom sort order for data sizes smallest -> largest
-SIZES = ["MINI", "SMALL", "MEDIUM", "LARGE", "EXTRALARGE", 'STANDARD']
-COMPACT_SZ = ["XS", "S", "M", "L", "XL", "STD"]
+SIZES = ["MINI", "SMALL", "MEDIUM", "LARGE", "EXTRALARGE", "HUGE", 'STANDARD']
+COMPACT_SZ = ["XS", "S", "M", "L", "XL", "XXL", "STD"]
+
+# run variants recorded in model files, and the value assumed when a
+# model does not record it
+VARIANTS = {'cache': 'cold', 'alloc': '4k', 'numa': 'none',
+            'threads': 'default', 'weak scaling': '0', 'affinity': 'none'}
 
 # directory sorting in tables left -> right
 SOURCES = ['original', "fission", "alt"]
@@ -64,7 +75,30 @@ def setup_args():
         "-d", "--data",
         action='store',
         default='time',
-        help="data choice: {time, speedup}"
+        help="data choice: {time, speedup, cache, report, roofline, "
+             "scaling, weak, affinity, paired}"
+    )
+    parser.add_argument(
+        "-k", "--key",
+        action='store',
+        default='rss_growth_kb',
+        help="reported field tabulated by --data report, e.g. "
+             "rss_growth_kb, alloc_bytes, minflt, nvcsw, utime "
+             "[default: rss_growth_kb]"
+    )
+    parser.add_argument(
+        "--roof",
+        action='store',
+        default=ROOFLINE_FILE,
+        help="machine ceilings measured by utilities/roofline.c "
+             f"[default: {ROOFLINE_FILE}]"
+    )
+    parser.add_argument(
+        "--sched",
+        action='store',
+        default=SCHEDULE_DIR,
+        help="results of utilities/schedule.sh for --data paired, a log "
+             f"or a directory of logs [default: {SCHEDULE_DIR}]"
     )
     parser.add_argument(
         "-o", "--out",
@@ -95,6 +129,41 @@ def setup_args():
         action="store",
         help="target directory for speedup [default: *]"
     )
+    parser.add_argument(
+        "--cache",
+        action="store",
+        default="cold",
+        help="cache state of time and speedup results: {cold, warm} "
+             "[default: cold]"
+    )
+    parser.add_argument(
+        "--alloc",
+        action="store",
+        default="4k",
+        help="allocation policy of results: {4k, thp, 2m, 1g} "
+             "[default: 4k]"
+    )
+    parser.add_argument(
+        "--numa",
+        action="store",
+        default="none",
+        help="NUMA placement of results: {none, interleave, local, bind:N} "
+             "[default: none]"
+    )
+    parser.add_argument(
+        "-t", "--threads",
+        action="store",
+        default="default",
+        help="OpenMP threads of results, as given to run.sh -t "
+             "[default: default]"
+    )
+    parser.add_argument(
+        "--affinity",
+        action="store",
+        default="none",
+        help="thread affinity of results, as given to run.sh -A "
+             "[default: none]"
+    )
     parser.add_argument(
         "--millis",
         action='store_true',
@@ -134,14 +203,15 @@ def parse_results(result_dir, dir_filter):
             if file_in else None
 
     def find_model(fn, models_):
-        stem = Path(fn).stem
-        return next(filter(lambda x: x.startswith(stem), models_), None)
+        model = Path(fn).stem + '_model.txt'
+        return model if model in models_ else None
 
-    def format_time(fn, variance, time, ts=0):
-        return fn.replace('_time', ''), float(variance), float(time), float(ts)
+    def format_time(fn, variance, time, ts=0, *reports):
+        return fn.replace('_time', ''), float(variance), float(time), \
+               float(ts), dict(r.split('=', 1) for r in reports if '=' in r)
 
     def parse_times(raw_times):
-        return [format_time(*rt.split(None, 3)) for rt in raw_times]
+        return [format_time(*rt.split()) for rt in raw_times if rt.strip()]
 
     def parse_model(raw_model):
         return {tup[0]: tup[1:] for tup in [
@@ -189,25 +259,34 @@ class Timing:
         self.opt_level = unpack('opt level')
         self.data_size = unpack('data size')
         self.source = unpack('source')
+        self.variant = {k: unpack(k) or v for k, v in VARIANTS.items()}
 
-    def find(self, opt, data_size, source):
+    def find(self, opt, data_size, source, variant=None):
         return self.source == source and \
                self.opt_level == opt and \
-               self.data_size == data_size
+               self.data_size == data_size and \
+               self.variant == dict(VARIANTS, **(variant or {}))
 
     def get_time(self, program):
         if program in self.programs:
             # 0: prog name, 1: variance, 2: run time
             return self.times[self.programs.index(program)][2]
 
+    def get_report(self, program, key):
+        """Value of a reported key=value field, e.g. reps or mad."""
+        if program in self.programs:
+            # 4: reported fields
+            return self.times[self.programs.index(program)][4].get(key)
+
 
 class ResultPresenter:
     """Represents a collection of results, and offers some formatting
     options """
 
     def __init__(self, results: List[Timing], in_dir, out_dir,
-                 time_millis, digits, pfilter, show):
+                 time_millis, digits, pfilter, show, variant=None):
         self.__results = results
+        self.variant = variant or {}
 
         # list of all (unique) recorded optimization levels
         self.opt_levels = sorted(
@@ -223,6 +302,16 @@ class ResultPresenter:
             list(set([r.source for r in results])),
             key=cmp_to_key(ResultPresenter.sources_sort))
 
+        # list of (unique) thread counts of thread sweeps
+        self.threads = sorted(set(
+            [int(r.variant['threads']) for r in results
+             if r.variant['threads'].isdigit()]))
+
+        # list of (unique) thread affinities, unbound first
+        self.affinities = sorted(
+            list(set([r.variant['affinity'] for r in results])),
+            key=lambda a: (a != 'none', a))
+
         # list of names of benchmarked programs
         self.programs = [p for p in sorted(list(set(
             chain.from_iterable([r.programs for r in results]))))
@@ -254,9 +343,11 @@ class ResultPresenter:
 
         return format(t, f'.{d}f')[:cap_len + dig_len]
 
-    def query(self, opt, size, source):
-        """Find timing result by given parameters."""
-        return next(filter(lambda x: x.find(opt, size, source),
+    def query(self, opt, size, source, **variant):
+        """Find timing result by given parameters; run variants not
+        given are those selected on the command line."""
+        variant = dict(self.variant, **variant)
+        return next(filter(lambda x: x.find(opt, size, source, variant),
                            self.__results), Timing())
 
     @property
@@ -316,14 +407,16 @@ class ResultPresenter:
         if show: w.write_table()
         print(f'Wrote result to: {f_path}')
 
-    def generate_table(self, sources, value_func, compact=False):
+    def generate_table(self, sources, value_func, compact=False, label=None):
         ops, prs, szs = self.opt_levels, self.programs, self.data_sizes
         lp, ld, lo, ls = len(prs), len(szs), len(ops), len(sources)
 
         # fill initial header rows
         opts = [ops[(c // ls) % lo] for c in range(lo * ls)]
         srcs = [sources[ci % ls] for ci in range(lo * ls)]
-        if compact:
+        if label:
+            srcs = [label(s) for s in srcs]
+        elif compact:
             srcs = [COMPACT_SRC[SOURCES.index(s)] for s in srcs]
         table = [['Program', ('Size' if compact else 'Data Size')]
                  + opts, ['', ''] + srcs]
@@ -358,7 +451,9 @@ class ResultPresenter:
             fn = "time_" + ("-".join(self.sources).lower()) + self.filter_names
             self.write_table(table, fmt, fn, self.out_dir, self.show)
 
-    def speedup(self, fmt, baseline, target):
+    def speedup_targets(self, baseline, target):
+        """Directories compared to baseline by a speedup, or None when
+        the results do not allow one."""
         src_len, r = len(self.sources), self.in_dir
         src_error = f'speedup requires timing at least two groups of ' \
                     f'programs, found {src_len} matching plot criteria'
@@ -369,19 +464,26 @@ class ResultPresenter:
             return print(src_error)
         if baseline not in self.sources:
             return print(bl_error)
-
-        bi = self.sources.index(baseline)
-        s1 = self.sources[bi]
-        sp = [n for i, n in enumerate(self.sources) if
-              (i != bi and (not target or target == n))]
         if len(self.programs) == 0:
             return print(pl_error)
 
+        bi = self.sources.index(baseline)
+        return [n for i, n in enumerate(self.sources) if
+                (i != bi and (not target or target == n))]
+
+    def speedup_value(self, p, d, o, s1, s2, **variant):
+        ts = self.query(o, d, s1, **variant).get_time(p)  # sequential
+        tp = self.query(o, d, s2, **variant).get_time(p)  # parallel
+        speedup = ts / tp if (ts and tp and tp > 0) else 0
+        return self.time_str(speedup, scale=False)
+
+    def speedup(self, fmt, baseline, target):
+        sp = self.speedup_targets(baseline, target)
+        if not sp:
+            return
+
         def value_func(p, d, o, s2):
-            ts = self.query(o, d, s1).get_time(p)  # sequential
-            tp = self.query(o, d, s2).get_time(p)  # parallel
-            speedup = ts / tp if (ts and tp and tp > 0) else 0
-            return self.time_str(speedup, scale=False)
+            return self.speedup_value(p, d, o, baseline, s2)
 
         table = self.generate_table(sp, value_func, compact=True)
         if fmt == "plot":
@@ -392,6 +494,414 @@ class ResultPresenter:
                  + self.filter_names
             self.write_table(table, fmt, fn, self.out_dir, self.show)
 
+    def cache_speedup(self, fmt, baseline, target):
+        """Speedup of each directory over baseline, with cold caches
+        and with warm caches side by side: whether a transformation
+        pays off only when the data is already in cache."""
+        sp = self.speedup_targets(baseline, target)
+        if not sp:
+            return
+        cols = [(s, c) for s in sp for c in ('cold', 'warm')]
+
+        def value_func(p, d, o, col):
+            return self.speedup_value(p, d, o, baseline, col[0],
+                                      cache=col[1])
+
+        label = lambda col: f'{COMPACT_SRC[SOURCES.index(col[0])]} {col[1]}'
+        table = self.generate_table(cols, value_func, True, label)
+        if fmt == "plot":
+            fn = lambda x: f'cache_{baseline}-{x[0]}-{x[1]}{self.filter_names}'
+            self.plot(table, fn, cols, "speedup", False)
+        else:
+            fn = "cache_" + ("-".join([baseline, target or 'all'])) \
+                 + self.filter_names
+            self.write_table(table, fmt, fn, self.out_dir, self.show)
+
+    def report(self, fmt, key):
+        """Table of a field reported by the programs, e.g. the memory
+        added by the kernel (rss_growth_kb) or the bytes allocated
+        (alloc_bytes)."""
+        if len(self.programs) == 0:
+            return print(f'no results match plot criteria')
+
+        def value_func(p, d, o, s):
+            v = self.query(o, d, s).get_report(p, key)
+            return format(float(v), f'.{self.digits}f') if v else '-'
+
+        table = self.generate_table(self.sources, value_func)
+        if fmt == "plot":
+            fn = lambda x: f'{key}_{x}{self.filter_names}'
+            self.plot(table, fn, self.sources, key, True)
+        else:
+            fn = f'{key}_' + ("-".join(self.sources).lower()) \
+                 + self.filter_names
+            self.write_table(table, fmt, fn, self.out_dir, self.show)
+
+    @staticmethod
+    def read_schedule(sched):
+        """Times of the blocks of utilities/schedule.sh logs: a list
+        of dicts, (source, results name suffix) -> (program, opt, size,
+        time), one per block."""
+        files = [sched] if path.isfile(sched) else sorted(
+            [path.join(sched, f) for f in
+             next(walk(sched), (None, None, []))[2]
+             if f.startswith('seed_')])
+        blocks = []
+        for line in chain.from_iterable([read_file(f) for f in files]):
+            if line.startswith('# block'):
+                blocks.append({})
+            elif line.strip() and not line.startswith('#') and blocks:
+                fields = line.split()
+                src, opt, size, *suffix = fields[0].split('_')
+                blocks[-1][(src, '_'.join(suffix))] = \
+                    (fields[1].replace('_time', ''), opt, size,
+                     float(fields[3]))
+        return blocks
+
+    def paired(self, fmt, baseline, target, sched):
+        """Speedup of paired samples: the median, over the blocks run
+        by utilities/schedule.sh, of the speedup of each source over the
+        baseline run in the same block, close in time."""
+        blocks = self.read_schedule(sched)
+        if not blocks:
+            return print(f'no schedule found in {sched}, '
+                         f'see utilities/schedule.sh')
+        if baseline not in self.sources:
+            return print(f'timing results not found for {baseline} '
+                         f'in {self.in_dir}')
+
+        samples = {}
+        for block in blocks:
+            for (s, sfx), (p, o, d, t) in block.items():
+                base = block.get((baseline, sfx))
+                if s != baseline and base and t > 0:
+                    samples.setdefault((sfx, p, d, o, s), []) \
+                        .append(base[3] / t)
+
+        def median(v):
+            v = sorted(v)
+            return (v[(len(v) - 1) // 2] + v[len(v) // 2]) / 2
+
+        sp = [n for n in self.sources if n != baseline and
+              (not target or target == n)]
+        if len(self.programs) == 0 or len(sp) == 0:
+            return print(f'no results match plot criteria')
+        for sfx in sorted(set([k[0] for k in samples])):
+            def value_func(p, d, o, s2):
+                v = samples.get((sfx, p, d, o, s2))
+                return self.time_str(median(v), scale=False) if v else '-'
+
+            table = self.generate_table(sp, value_func, compact=True)
+            name = f'paired_{baseline}-{{}}{"_" + sfx if sfx else ""}' \
+                   f'{self.filter_names}'
+            if fmt == "plot":
+                self.plot(table, lambda x: name.format(x), sp,
+                          "paired speedup", False)
+            else:
+                self.write_table(table, fmt, name.format(target or 'all'),
+                                 self.out_dir, self.show)
+
+    @staticmethod
+    def read_roofline(roof_file):
+        """Peak GFLOP/s and GB/s of the machine, as printed by
+        utilities/roofline.c"""
+        if not path.exists(roof_file):
+            return None
+        fields = dict(f.split('=', 1) for line in read_file(roof_file)
+                      if 'roofline:' in line
+                      for f in line.split('roofline:', 1)[1].split()
+                      if '=' in f)
+        return float(fields['peak_gflops']), float(fields['peak_gbs'])
+
+    def roofline_point(self, p, d, o, s, peaks):
+        """Arithmetic intensity, GFLOP/s and GB/s of a result, and the
+        fraction of the roofline bound reached: the bound is the time
+        of the modelled flops at peak rate, or of the modelled bytes at
+        peak bandwidth, whichever is longer."""
+        res = self.query(o, d, s)
+        t = res.get_time(p)
+        flops, nbytes = res.get_report(p, 'flops'), res.get_report(p, 'bytes')
+        if not t or t <= 0 or flops is None or nbytes is None:
+            return None
+        flops, nbytes = float(flops), float(nbytes)
+        t_flops, t_bytes = flops / peaks[0] / 1e9, nbytes / peaks[1] / 1e9
+        return {'intensity': flops / nbytes if nbytes > 0 else 0,
+                'gflops': flops / t / 1e9, 'gbs': nbytes / t / 1e9,
+                'fraction': max(t_flops, t_bytes) / t,
+                'bound': 'mem' if t_bytes >= t_flops else 'fp'}
+
+    def roofline(self, fmt, roof_file):
+        """Position of each result under the machine roofline."""
+        peaks = self.read_roofline(roof_file)
+        if not peaks:
+            return print(f'machine ceilings not found in {roof_file}, '
+                         f'see utilities/roofline.c')
+        if len(self.programs) == 0:
+            return print(f'no results match plot criteria')
+
+        if fmt == "plot":
+            return self.plot_roofline(peaks)
+
+        def value_func(p, d, o, s):
+            pt = self.roofline_point(p, d, o, s, peaks)
+            if not pt:
+                return '-'
+            return f'{100 * pt["fraction"]:.{self.digits}f}% {pt["bound"]}'
+
+        table = self.generate_table(self.sources, value_func)
+        fn = "roofline_" + ("-".join(self.sources).lower()) \
+             + self.filter_names
+        self.write_table(table, fmt, fn, self.out_dir, self.show)
+
+    def plot_roofline(self, peaks):
+        from matplotlib import pyplot as plt
+
+        markers = ['o', 's', '^', 'D', 'v', 'P']
+        for d in self.data_sizes:
+            fig, ax = plt.subplots(**SPLOT, figsize=(6, 4))
+            points = [(p, o, s, self.roofline_point(p, d, o, s, peaks))
+                      for p in self.programs for o in self.opt_levels
+                      for s in self.sources]
+            points = [x for x in points if x[3] and x[3]['gflops'] > 0]
+            if not points:
+                plt.close(fig)
+                continue
+
+            # ceilings: bandwidth slope up to the ridge, then flat
+            ridge = peaks[0] / peaks[1]
+            xs = [x[3]['intensity'] for x in points]
+            x_lo, x_hi = min(min(xs), ridge) / 4, max(max(xs), ridge) * 4
+            ax.plot([x_lo, ridge, x_hi],
+                    [x_lo * peaks[1], peaks[0], peaks[0]],
+                    color='#777', lw=1.5, zorder=2)
+
+            for p, o, s, pt in points:
+                c = self.color(self.sources.index(s))
+                m = markers[self.opt_levels.index(o) % len(markers)]
+                ax.scatter(pt['intensity'], pt['gflops'], color=c, marker=m,
+                           s=18, **BARS)
+                ax.annotate(p, (pt['intensity'], pt['gflops']), fontsize=5,
+                            xytext=(3, 3), textcoords='offset points')
+
+            handles = [plt.Line2D([0], [0], color=self.color(i), **LSYMBOL)
+                       for i in range(len(self.sources))] + \
+                      [plt.Line2D([0], [0], color='black', lw=0,
+                                  marker=markers[i % len(markers)],
+                                  markersize=4)
+                       for i in range(len(self.opt_levels))]
+            ax.legend(handles, self.sources + self.opt_levels, fontsize=6,
+                      frameon=False, loc='lower right')
+            ax.set_xscale('log')
+            ax.set_yscale('log')
+            ax.set_xlabel('arithmetic intensity (flop/byte)')
+            ax.set_ylabel('GFLOP/s')
+            ax.yaxis.grid(True, **YGRID)
+            ax.spines['right'].set_visible(False)
+            ax.spines['top'].set_visible(False)
+            fig.tight_layout()
+
+            f_path = path.join(self.out_dir,
+                               f'roofline_{d}{self.filter_names}.pdf')
+            plt.savefig(f_path)
+            print(f'Saved plot to to: {f_path}')
+            if self.show:
+                plt.show()
+
+    def scaling_point(self, p, d, o, s, n, baseline, weak=False):
+        """Speedup and parallel efficiency of a source run with n
+        threads, over the baseline source run with 1 thread. With weak
+        scaling (run.sh -W), the work grows with the threads: the
+        efficiency is the ratio of the times, and the speedup is scaled
+        by the work, n times the efficiency."""
+        w = {'weak scaling': '1' if weak else '0'}
+        t1 = self.query(o, d, baseline, threads='1', **w).get_time(p)
+        tn = self.query(o, d, s, threads=str(n), **w).get_time(p)
+        if not t1 or not tn or tn <= 0:
+            return None
+        return (n * t1 / tn, t1 / tn) if weak else (t1 / tn, t1 / tn / n)
+
+    def scaling(self, fmt, baseline, weak=False):
+        """Strong or weak scaling of thread sweeps (run.sh -t, -W), one
+        table per optimization level: speedup and efficiency per thread
+        count."""
+        if len(self.threads) < 2:
+            return print(f'scaling requires results of at least two thread '
+                         f'counts, found {len(self.threads)}; see run.sh -t')
+        w = '1' if weak else '0'
+        if '1' not in [r.variant['threads'] for r in self.__results
+                       if r.source == baseline
+                       and r.variant['weak scaling'] == w]:
+            return print(f'1-thread results not found for {baseline} '
+                         f'in {self.in_dir}')
+        if len(self.programs) == 0:
+            return print(f'no results match plot criteria')
+
+        if fmt == "plot":
+            return self.plot_scaling(baseline, weak)
+
+        ths, srcs = self.threads, self.sources
+        for o in self.opt_levels:
+            table = [['Program', 'Size'] + [f't{n}' for s in srcs
+                                            for n in ths],
+                     ['', ''] + [s for s in srcs for n in ths]]
+            for p in self.programs:
+                for i, d in enumerate(self.data_sizes):
+                    row = [p if i == 0 else '', d]
+                    for s in srcs:
+                        for n in ths:
+                            pt = self.scaling_point(p, d, o, s, n, baseline,
+                                                    weak)
+                            row.append(f'{pt[0]:.{self.digits}f} '
+                                       f'({100 * pt[1]:.0f}%)'
+                                       if pt else '-')
+                    table.append(row)
+            fn = f'{"weak" if weak else "scaling"}_{o}_{baseline}-' \
+                 + ("-".join(srcs).lower()) \
+                 + self.filter_names
+            self.write_table(table, fmt, fn, self.out_dir, self.show)
+
+    def plot_scaling(self, baseline, weak):
+        from matplotlib import pyplot as plt
+        from matplotlib.lines import Line2D
+
+        rows, cols = min(-(-self.prog_count // 3), 5), min(self.prog_count, 3)
+        ths = self.threads
+
+        # a speedup and an efficiency figure per opt level and data size
+        for o in self.opt_levels:
+            for d in self.data_sizes:
+                for k, name in enumerate(['speedup', 'efficiency']):
+                    fig, axs = plt.subplots(rows, cols, **SPLOT,
+                                            figsize=(cols * 3, rows * 3))
+                    axs = axs.flatten() if self.prog_count > 1 else [axs]
+
+                    for sub_plot, p in zip(axs, self.programs):
+                        ideal = ths if k == 0 else [1 for _ in ths]
+                        sub_plot.plot(ths, ideal, color='#777', lw=1,
+                                      ls='--', zorder=2)
+                        lines = [Line2D([0], [0], color='#777', lw=1,
+                                        ls='--')]
+                        for i, s in enumerate(self.sources):
+                            pts = [(n, self.scaling_point(
+                                p, d, o, s, n, baseline, weak)) for n in ths]
+                            pts = [(n, pt[k]) for n, pt in pts if pt]
+                            c = self.color(i)
+                            sub_plot.plot([x[0] for x in pts],
+                                          [x[1] for x in pts], color=c,
+                                          marker='o', markersize=3, lw=1,
+                                          zorder=3)
+                            lines.append(Line2D([0], [0], color=c,
+                                                **LSYMBOL))
+                        sub_plot.legend(lines, ['ideal'] + self.sources,
+                                        **LEGEND)
+
+                        sub_plot.set_xscale('log', base=2)
+                        sub_plot.set_xticks(ths, [str(n) for n in ths])
+                        if k == 1:
+                            sub_plot.set_ylim((0, 1.2))
+                        sub_plot.yaxis.grid(True, **YGRID)
+                        sub_plot.set_ylabel(('scaled ' if weak and k == 0
+                                             else '') + name)
+                        sub_plot.set_xlabel(f'{p} (threads)', labelpad=0)
+                        sub_plot.spines['right'].set_visible(False)
+                        sub_plot.spines['top'].set_visible(False)
+
+                    for idx in range(self.prog_count, rows * cols):
+                        fig.delaxes(axs[idx])
+
+                    fig.tight_layout()
+                    f_path = path.join(
+                        self.out_dir, f'{"weak_" if weak else ""}{name}_'
+                                      f'{o}_{d}_{baseline}'
+                                      f'{self.filter_names}.pdf')
+                    plt.savefig(f_path)
+                    print(f'Saved plot to to: {f_path}')
+                    if self.show:
+                        plt.show()
+                    plt.close(fig)
+
+    def affinity(self, fmt):
+        """Times of each thread affinity (run.sh -A), one table per
+        optimization level; the fastest affinity of each program, size
+        and source is marked with a *."""
+        if len(self.affinities) < 2:
+            return print(f'affinity requires results of at least two '
+                         f'affinities, found {len(self.affinities)}; '
+                         f'see run.sh -A')
+        if len(self.programs) == 0:
+            return print(f'no results match plot criteria')
+
+        if fmt == "plot":
+            return self.plot_affinity()
+
+        affs, srcs = self.affinities, self.sources
+        for o in self.opt_levels:
+            table = [['Program', 'Size'] + [a for s in srcs for a in affs],
+                     ['', ''] + [s for s in srcs for a in affs]]
+            for p in self.programs:
+                for i, d in enumerate(self.data_sizes):
+                    row = [p if i == 0 else '', d]
+                    for s in srcs:
+                        ts = [self.query(o, d, s, affinity=a).get_time(p)
+                              for a in affs]
+                        best = min([t for t in ts if t], default=None)
+                        row += [self.time_str(t) + (' *' if t == best else '')
+                                if t else '-' for t in ts]
+                    table.append(row)
+            fn = f'affinity_{o}_' + ("-".join(srcs).lower()) \
+                 + self.filter_names
+            self.write_table(table, fmt, fn, self.out_dir, self.show)
+
+    def plot_affinity(self):
+        from matplotlib import pyplot as plt
+        from matplotlib.lines import Line2D
+
+        rows, cols = min(-(-self.prog_count // 3), 5), min(self.prog_count, 3)
+        affs, srcs = self.affinities, self.sources
+        bw = 0.80 / len(affs)
+
+        # a figure per opt level and data size: a group of bars per
+        # source, a bar per affinity
+        for o in self.opt_levels:
+            for d in self.data_sizes:
+                fig, axs = plt.subplots(rows, cols, **SPLOT,
+                                        figsize=(cols * 3, rows * 3))
+                axs = axs.flatten() if self.prog_count > 1 else [axs]
+
+                for sub_plot, p in zip(axs, self.programs):
+                    lines = []
+                    for i, a in enumerate(affs):
+                        pos = [x + (i - (len(affs) - 1) / 2) * bw
+                               for x in range(len(srcs))]
+                        values = [self.query(o, d, s, affinity=a)
+                                  .get_time(p) or 0 for s in srcs]
+                        c = self.color(i)
+                        sub_plot.bar(pos, values, color=c, width=bw, **BARS)
+                        lines.append(Line2D([0], [0], color=c, **LSYMBOL))
+                    sub_plot.legend(lines, affs, **dict(LEGEND, ncol=2),
+                                    fontsize=5)
+                    sub_plot.set_yscale('log')
+                    sub_plot.yaxis.grid(True, **YGRID)
+                    sub_plot.set_ylabel(
+                        f'clock time ({"ms" if self.millis else "s"})')
+                    sub_plot.set_xlabel(p, labelpad=0)
+                    sub_plot.set_xticks(range(len(srcs)), srcs)
+                    sub_plot.tick_params(axis="x", length=0, pad=4)
+                    sub_plot.spines['right'].set_visible(False)
+                    sub_plot.spines['top'].set_visible(False)
+
+                for idx in range(self.prog_count, rows * cols):
+                    fig.delaxes(axs[idx])
+
+                fig.tight_layout()
+                f_path = path.join(self.out_dir, f'affinity_{o}_{d}'
+                                                 f'{self.filter_names}.pdf')
+                plt.savefig(f_path)
+                print(f'Saved plot to to: {f_path}')
+                if self.show:
+                    plt.show()
+                plt.close(fig)
+
     def plot(self, data, fn, prog_dir, ylabel, log):
         from matplotlib import pyplot as plt
         from matplotlib.lines import Line2D
@@ -472,9 +982,26 @@ if __name__ == '__main__':
         time_millis=args.millis,
         digits=args.digits,
         pfilter=prog_fil,
-        show=args.show)
+        show=args.show,
+        variant={'cache': args.cache, 'alloc': args.alloc,
+                 'numa': args.numa, 'threads': args.threads,
+                 'affinity': args.affinity})
 
     if args.data == "speedup":
         rp.speedup(args.fmt, args.ss, args.st)
+    elif args.data == "cache":
+        rp.cache_speedup(args.fmt, args.ss, args.st)
+    elif args.data == "report":
+        rp.report(args.fmt, args.key)
+    elif args.data == "roofline":
+        rp.roofline(args.fmt, args.roof)
+    elif args.data == "scaling":
+        rp.scaling(args.fmt, args.ss)
+    elif args.data == "weak":
+        rp.scaling(args.fmt, args.ss, weak=True)
+    elif args.data == "affinity":
+        rp.affinity(args.fmt)
+    elif args.data == "paired":
+        rp.paired(args.fmt, args.ss, args.st, args.sched)
     else:
         rp.times(args.fmt)
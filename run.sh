@@ -5,45 +5,149 @@
 # This script compiles all examples in source directory then runs the built-in
 # timing benchmark script. Output is stored in a timestamped file.
 #
+# Compiling is a separate stage: binaries missing from the cache in compiled/
+# are first built in parallel, then the programs are timed one at a time.
+# Binaries are cached under a hash of the compiler, the flags (data size
+# included) and the contents of the sources and headers, and reused by later
+# runs; -x only prints the commands compiling the missing ones.
+#
 # basic usage:
 # ./run.sh
+#
+# thread sweep (strong scaling), one result file per thread count:
+# ./run.sh -d fission -t sweep
+#
+# weak scaling, sizes of the data set per thread:
+# ./run.sh -d fission -s MEDIUM -t sweep -W
+#
+# thread affinity sweep, one result file per binding and placement:
+# ./run.sh -d fission -t 4 -A close:cores,spread:cores
 
 
 # parse command line args
-while getopts c:o:d:v:s:p: flag
+ARGS=("$@")
+while getopts c:o:d:e:b:s:p:r:mwa:n:Pykt:WA:S:x flag
 do
     case "${flag}" in
         c) compiler=${OPTARG};;
         o) opt_level=${OPTARG};;
         d) directory=${OPTARG};;
-        v) max_var=${OPTARG};;
+        e) ci_target=${OPTARG};;
+        b) budget=${OPTARG};;
         s) size=${OPTARG};;
         p) prog=${OPTARG};;
+        r) reps=${OPTARG};;
+        m) ompt=1;;
+        w) cache=warm;;
+        a) alloc=${OPTARG};;
+        n) numa=${OPTARG};;
+        P) padding=off;;
+        y) dynamic=1;;
+        k) datasets=1;;
+        t) threads=${OPTARG};;
+        W) weak=1;;
+        A) affinity=${OPTARG};;
+        S) seed=${OPTARG};;
+        x) build=1;;
         *) ;;
     esac
 done
 
-VALID_SIZES=("MINI","SMALL","MEDIUM","LARGE","EXTRALARGE","STANDARD")
+VALID_SIZES=("MINI","SMALL","MEDIUM","LARGE","EXTRALARGE","HUGE","STANDARD")
+VALID_ALLOCS=("4k" "thp" "2m" "1g")
 
 # Unpack the args and set defaults
 CC="${compiler:-gcc}"                       # compiler, default: gcc
 OPT="${opt_level:-O0}"                      # optimization level, default: O0
 SRC="${directory:-original}"                # source directory, default: original
-MAX_VARIANCE="${max_var:-5.0}"              # max allowed variance b/w timing results
-DS_SIZE=${size:-STANDARD}                   # dataset size: MINI, SMALL, MEDIUM, LARGE, EXTRALARGE
+CI_TARGET="${ci_target:-1.0}"               # target half-width (%) of the median's 95% CI
+TIME_BUDGET="${budget:-30}"                 # max. sampling time per program (s)
+DS_SIZE=${size:-STANDARD}                   # dataset size: MINI, SMALL, MEDIUM, LARGE, EXTRALARGE, HUGE
 PROGRAM=${prog}                             # benchmark specific program
+REPS=${reps:-5}                             # min. kernel repetitions per execution
+OMPT=${ompt:-0}                             # measure OpenMP runtime overhead, default: no
+CACHE=${cache:-cold}                        # cache state of timed kernels: cold (flushed), warm
+ALLOC=${alloc:-4k}                          # array pages: 4k, thp, 2m, 1g
+NUMA=${numa:-none}                          # array placement: none, interleave, local, bind:N
+PADDING=${padding:-tuned}                   # array padding: tuned (from eval/padding), off
+DYNAMIC=${dynamic:-0}                       # sizes read at run time by reusable binaries, default: no
+DATASETS=${datasets:-0}                     # load initialized arrays from a cache, default: no
+THREADS=${threads:-default}                 # OpenMP threads: N, list N,M,..., sweep; default: runtime's
+WEAK=${weak:-0}                             # grow sizes with the threads (weak scaling), default: no
+AFFINITY=${affinity:-none}                  # thread binding BIND[:PLACES], list, sweep; default: runtime's
+SEED=${seed}                                # seed of utilities/schedule.sh, when run by it
+BUILD=${build:-0}                           # only print the commands compiling missing binaries
+JOBS=${BUILD_JOBS:-$(getconf _NPROCESSORS_ONLN 2>/dev/null || echo 1)}   # parallel compiles
+
+# weak scaling changes the sizes at run time
+[[ $WEAK == "1" ]] && DYNAMIC=1
+
+# a list of thread counts, or sweep (1, 2, 4, ... up to the number of
+# cores, and the number of cores), runs this script once per count
+if [[ $THREADS == "sweep" ]]; then
+    cores=$(getconf _NPROCESSORS_ONLN 2>/dev/null || echo 1)
+    THREADS=""
+    for (( t=1 ; t<cores ; t*=2 )); do THREADS+="$t,"; done
+    THREADS+="$cores"
+fi
+if [[ $THREADS == *,* ]]; then
+    for t in ${THREADS//,/ }; do
+        "$0" "${ARGS[@]}" -t "$t" || exit 1
+    done
+    exit 0
+fi
+
+# likewise for a list of affinities, or sweep (close, spread and master
+# binding, each on cores, hardware threads and sockets)
+if [[ $AFFINITY == "sweep" ]]; then
+    AFFINITY=""
+    for bind in close spread master; do
+        for places in cores threads sockets; do AFFINITY+="$bind:$places,"; done
+    done
+    AFFINITY="${AFFINITY%,}"
+fi
+if [[ $AFFINITY == *,* ]]; then
+    for a in ${AFFINITY//,/ }; do
+        "$0" "${ARGS[@]}" -A "$a" || exit 1
+    done
+    exit 0
+fi
+
+if [[ ! $THREADS =~ ^(default|[1-9][0-9]*)$ ]]; then
+    echo "[ERROR]: "$THREADS" is not a valid choice for threads";
+    echo "Use one of: default N N,M,... sweep"
+    exit 1;
+fi
+if [[ ! $AFFINITY =~ ^(none|(close|spread|master|true|false)(:(cores|threads|sockets|ll_caches|numa_domains))?)$ ]]; then
+    echo "[ERROR]: "$AFFINITY" is not a valid choice for affinity";
+    echo "Use one of: none BIND[:PLACES] (BIND: close spread master true false;"
+    echo "PLACES: cores threads sockets ll_caches numa_domains), a list, sweep"
+    exit 1;
+fi
+if [[ $WEAK == "1" && $THREADS == "default" ]]; then
+    echo "[ERROR]: weak scaling (-W) needs a number of threads (-t)";
+    exit 1;
+fi
 
 # configure other runtime options
-MAX_RETRIES=100                             # stop repeating after N retries
 START=$(date '+%H:%M:%S');                  # start time
 DT=$(date '+%m%d%H%M%S');                   # current timestamp
 
 # output directories
 CDIR="compiled"                             # for holding compiled programs
 RES_DIR="eval/results"                           # where to save results
+PAD_DIR="eval/padding"                      # padding chosen by utilities/tune_padding.sh
+DATA_DIR="eval/datasets"                    # initialized arrays cached by the programs
+SCHED_DIR="eval/schedule"                   # results in run order, by utilities/schedule.sh
 
 # output filenames
 PATTERN="$SRC"_"$OPT"_"$DS_SIZE"
+[[ $CACHE == "warm" ]] && PATTERN+="_warm"
+[[ $ALLOC != "4k" ]] && PATTERN+="_$ALLOC"
+[[ $NUMA != "none" ]] && PATTERN+="_${NUMA/:/}"
+[[ $WEAK == "1" ]] && PATTERN+="_weak"
+[[ $THREADS != "default" ]] && PATTERN+="_t$THREADS"
+[[ $AFFINITY != "none" ]] && PATTERN+="_${AFFINITY/:/-}"
 OUTFILE=./"$RES_DIR"/"$PATTERN".txt       # where to save timing results
 MODEL=./"$RES_DIR"/"$PATTERN"_model.txt   # where to save machine details
 
@@ -60,104 +164,264 @@ if [[ $inarray == "0" ]]; then
     exit 1;
 fi
 
+if [[ ! " ${VALID_ALLOCS[*]} " == *" $ALLOC "* ]]; then
+    echo "[ERROR]: "$ALLOC" is not a valid choice for allocation policy";
+    echo "Use one of: ${VALID_ALLOCS[*]}"
+    exit 1;
+fi
+
+if [[ ! $NUMA =~ ^(none|interleave|local|bind:[0-9]+)$ ]]; then
+    echo "[ERROR]: "$NUMA" is not a valid choice for NUMA placement";
+    echo "Use one of: none interleave local bind:N"
+    exit 1;
+fi
+
 # ensure dirs exist
 [ -d "$CDIR" ] || mkdir "$CDIR"
 [ -d "$RES_DIR" ] || mkdir -p "$RES_DIR"
 
-# capture runtime details
+# compiler identity and hash command, for the keys of the binary cache
+CC_ID=$("$CC" --version 2>/dev/null | head -n 1)
+HASH=(sha256sum)
+command -v sha256sum > /dev/null || HASH=(shasum -a 256)
+
+# build stage: the missing binaries are compiled in parallel with the
+# commands printed by -x, which records and runs nothing
+if [[ $BUILD == "1" ]]; then
+    MODEL=/dev/null
+    OMPT=0
+else
+    builds=$("$0" "${ARGS[@]}" -x | sort -u)
+    if [[ -n $builds ]]; then
+        echo "  ⧗ compiling $(echo "$builds" | wc -l | xargs) program(s), $JOBS at a time"
+        echo "$builds" | tr '\n' '\0' | xargs -0 -n 1 -P "$JOBS" bash -c
+    fi
+fi
+
+# capture runtime details, each run; the machine, once per model file
+[[ -f "$MODEL" ]] && new_model=0 || new_model=1
 echo "# RUNTIME" >>  "$MODEL"
 echo "compiler: "$CC"" >>  "$MODEL"
 echo "opt level: "$OPT"" >>  "$MODEL"
 echo "source: "$SRC"" >>  "$MODEL"
 echo "data size: "$DS_SIZE"" >>  "$MODEL"
-echo "# MACHINE" >>  "$MODEL"
-echo "OS: "$OSTYPE"" >> "$MODEL"
+echo "repetitions: "$REPS"" >>  "$MODEL"
+echo "ci target: "$CI_TARGET"" >>  "$MODEL"
+echo "time budget: "$TIME_BUDGET"" >>  "$MODEL"
+echo "ompt: "$OMPT"" >>  "$MODEL"
+echo "cache: "$CACHE"" >>  "$MODEL"
+echo "alloc: "$ALLOC"" >>  "$MODEL"
+echo "numa: "$NUMA"" >>  "$MODEL"
+echo "padding: "$PADDING"" >>  "$MODEL"
+echo "dynamic sizes: "$DYNAMIC"" >>  "$MODEL"
+echo "dataset cache: "$DATASETS"" >>  "$MODEL"
+echo "threads: "$THREADS"" >>  "$MODEL"
+echo "weak scaling: "$WEAK"" >>  "$MODEL"
+echo "affinity: "$AFFINITY"" >>  "$MODEL"
+[[ -n $SEED ]] && echo "schedule seed: "$SEED"" >>  "$MODEL"
 
 # capture details of running machine
-case "$OSTYPE" in
-  linux*)   cat /proc/cpuinfo >> "$MODEL" ;;
-  darwin*)  sysctl -a | grep machdep.cpu >> "$MODEL" ;;
-  solaris*) echo "no details on SOLARIS"  >> "$MODEL" ;;
-  bsd*)     echo "no details on BSD" >> "$MODEL" ;;
-  msys*)    echo "no details on WINDOWS" >> "$MODEL" ;;
-  cygwin*)  echo "no details on ALSO WINDOWS" >> "$MODEL"  ;;
-  *)        echo "no details on unknown: $OSTYPE" >> "$MODEL"  ;;
-esac
-
-# clear compiled files if exist
-for file in ./"$CDIR"/*
-do
-    rm -rf "$file"
-done
+if [[ $new_model == "1" ]]; then
+    echo "# MACHINE" >>  "$MODEL"
+    echo "OS: "$OSTYPE"" >> "$MODEL"
+    case "$OSTYPE" in
+      linux*)   cat /proc/cpuinfo >> "$MODEL" ;;
+      darwin*)  sysctl -a | grep machdep.cpu >> "$MODEL" ;;
+      solaris*) echo "no details on SOLARIS"  >> "$MODEL" ;;
+      bsd*)     echo "no details on BSD" >> "$MODEL" ;;
+      msys*)    echo "no details on WINDOWS" >> "$MODEL" ;;
+      cygwin*)  echo "no details on ALSO WINDOWS" >> "$MODEL"  ;;
+      *)        echo "no details on unknown: $OSTYPE" >> "$MODEL"  ;;
+    esac
+fi
+
+# build the OMPT tool; it needs omp-tools.h, and a runtime implementing
+# OMPT: GNU libgomp does not, so LLVM libomp is preloaded in its place
+OMPT_TOOL=./utilities/ompt_tool.so
+if [[ $OMPT == "1" ]]; then
+    for dir in "$OMPT_INCLUDE" "$(dirname "$("$CC" -print-file-name=include/omp-tools.h)")" \
+               /usr/lib/llvm-*/lib/clang/*/include /usr/local/include /usr/include; do
+        [ -f "$dir"/omp-tools.h ] && { OMPT_INCLUDE="$dir"; break; }
+    done
+    runtime=""
+    for lib in "$OMPT_RUNTIME" /usr/lib/llvm-*/lib/libomp.so.5 /usr/lib/x86_64-linux-gnu/libomp.so.5 \
+               /usr/local/lib/libomp.so; do
+        [ -f "$lib" ] && { runtime="$lib"; break; }
+    done
+    OMPT_RUNTIME=$runtime
+    if ! "$CC" -shared -fPIC -O2 -I "$OMPT_INCLUDE" utilities/ompt_tool.c -o "$OMPT_TOOL"; then
+        echo "[ERROR]: cannot build the OMPT tool; set OMPT_INCLUDE to the directory of omp-tools.h"
+        exit 1;
+    fi
+fi
+
+# initialized arrays are stored by the first execution of each program,
+# and loaded instead of computed by the next ones
+run_env=()
+[[ $DATASETS == "1" ]] && run_env=(POLYBENCH_DATASET_CACHE="$DATA_DIR")
+
+# the OpenMP team size, when set, is passed to every execution
+[[ $THREADS != "default" ]] && run_env+=(OMP_NUM_THREADS="$THREADS")
+
+# and so are the binding of the threads, and their places
+if [[ $AFFINITY != "none" ]]; then
+    run_env+=(OMP_PROC_BIND="${AFFINITY%%:*}")
+    [[ $AFFINITY == *:* ]] && run_env+=(OMP_PLACES="${AFFINITY#*:}")
+fi
+applied=""
+
+# value of the macro $2 in the preprocessor definitions $1
+define_value()
+{
+    echo "$1" | awk -v d="$2" '$1 == "#define" && $2 == d { print $3 }'
+}
 
 # compile and time each example
 for file in ./"$SRC"/*.c
 do
 
-    i=0 # counter for timing retries
-
     # get filename without extension
     filename=$(basename -- "$file")
     extension="${filename##*.}"
     filename="${filename%.*}"
-    out=./"$CDIR"/"$filename"_time
 
     # benchmark only specific program
     if [ -n "$PROGRAM" ]; then
         [[ "$PROGRAM" != "$filename" ]] && continue
     fi
 
-    # compile options
-    "$CC" "$file" -"$OPT" -lm -fopenmp -I utilities -I headers utilities/polybench.c -DPOLYBENCH_TIME -D"$DS_SIZE"_DATASET -o "$out"
-
-    while : ; do
-
-        # run benchmark
-        result=$(/bin/sh ./utilities/time_benchmark.sh "$out")
-
-        result_arr=($result)            # split by whitespace
-        variance=${result_arr[1]}       # get recorded variance
-        i=$((i+1))                      # iteration counter
-
-        # if variance is withing allowed range, or max retries exhausted
-        if(( $(bc <<< "$variance < $MAX_VARIANCE") )) || [ $i -gt $MAX_RETRIES ]; then
-
-            res_n_time="${result}"$'\t'"$(date '+%s')"
-            if test -f "$OUTFILE"; then
-              # remove previous result for this benchmark, if found
-              IFS=$'\n' read -d '' -r -a lines < "$OUTFILE"
-              for (( lineno=${#lines[@]}-1 ; lineno>=0 ; lineno-- )) ; do
-                 if [[ "${lines[$lineno]}" = "$filename"* ]]; then
-                    unset 'lines[lineno]'
-                 fi
-              done
-              # append and write out
-              lines+=("${res_n_time}")
-              printf "%s\n" "${lines[@]}" > "$OUTFILE"
-            else
-              printf "%s\n" "${res_n_time}" > "$OUTFILE"
-            fi
+    # padding tuned for this program and configuration, if any
+    pad_flags=()
+    conf=./"$PAD_DIR"/"$SRC"_"$(basename -- "$CC")"_"$OPT"_"$DS_SIZE"_"$filename".conf
+    if [[ $PADDING == "tuned" && -f "$conf" ]]; then
+        pad=$(sed -n 's/^PADDING_FACTOR=//p' "$conf")
+        inter=$(sed -n 's/^INTER_ARRAY_PADDING_FACTOR=//p' "$conf")
+        [[ -n $pad && $pad != "0" ]] && pad_flags+=(-DPOLYBENCH_PADDING_FACTOR="$pad")
+        [[ -n $inter && $inter != "0" ]] && pad_flags+=(-DPOLYBENCH_INTER_ARRAY_PADDING_FACTOR="$inter")
+    fi
 
-            # clean up terminal output on last line
-            if [ $i -gt 0 ]; then
-                printf '\r'
-                        cols="$(tput cols)"
-                        for i in $(seq "$cols"); do
-                                printf ' '
-                        done
-                printf '\r'
+    # with dynamic sizes, one binary per program, compiler, optimization
+    # level and padding serves all data sizes, and the sizes of the data
+    # set, read from the benchmark header, are passed in the environment
+    size_flags=(-D"$DS_SIZE"_DATASET)
+    size_env=()
+    if [[ $DYNAMIC == "1" ]]; then
+        size_flags=(-DPOLYBENCH_DYNAMIC_SIZES)
+        [[ $DS_SIZE == "HUGE" ]] && size_flags+=(-DPOLYBENCH_USE_LONG_INDEX)
+        defs=$("$CC" -E -dM -D"$DS_SIZE"_DATASET -I utilities headers/"$filename".h)
+        # with weak scaling, the data set is the size per thread: the sizes
+        # listed in the header (POLYBENCH_WEAK_DIMS) are multiplied by
+        # threads^(1/d), d being the degree of the work in them
+        # (POLYBENCH_WEAK_DEGREE), so that the work per thread is constant
+        weak_dims=""
+        if [[ $WEAK == "1" ]]; then
+            weak_dims=$(echo "$defs" | sed -n 's/^#define POLYBENCH_WEAK_DIMS "\(.*\)"$/\1/p')
+            weak_degree=$(define_value "$defs" POLYBENCH_WEAK_DEGREE)
+        fi
+        for dim in $(sed -n 's/^POLYBENCH_DYNAMIC_SIZE(\(.*\))$/\1/p' headers/"$filename".h); do
+            value=$(define_value "$defs" "$dim")
+            if [[ " $weak_dims " == *" $dim "* ]]; then
+                value=$(awk -v v="$value" -v t="$THREADS" -v d="$weak_degree" \
+                        'BEGIN { printf "%.0f", v * t ^ (1 / d) }')
             fi
+            size_env+=("POLYBENCH_SIZE_$dim=$value")
+        done
+    fi
+
+    # compile options
+    cflags=(-"$OPT" -fopenmp -I utilities -I headers utilities/polybench.c -DPOLYBENCH_TIME -DPOLYBENCH_MONOTONIC_TIMER -DPOLYBENCH_REPEAT -DPOLYBENCH_OMPT -DPOLYBENCH_RUSAGE "${size_flags[@]}" "${pad_flags[@]}")
 
-            echo -e "\033[1;32m✓\033[0m ($(date '+%H:%M:%S')) done with ("$DS_SIZE", -"$OPT", "$SRC"): ${filename}"
-            printf '\r'
-            break
+    # cache key: the compiler, the flags, and the contents of the files
+    # the program is built from, as listed by the compiler
+    deps=$("$CC" -MM "${cflags[@]}" "$file" 2>/dev/null | sed -e 's/^[^:]*://' -e 's/\\$//' | tr -s ' ' '\n' | sort -u)
+    key=$({ echo "$CC_ID"; printf '%s\n' "$CC" "${cflags[@]}"; cat $deps; } | "${HASH[@]}" | cut -c1-16)
+    out=./"$CDIR"/"$key"/"$filename"_time
+
+    # compile into the cache, if missing; the binary appears only once
+    # complete
+    if [[ ! -x "$out" ]]; then
+        compile=("$CC" "$file" "${cflags[@]}" -lm -o "$out".tmp)
+        if [[ $BUILD == "1" ]]; then
+            echo "mkdir -p $(printf '%q' "${out%/*}") && $(printf '%q ' "${compile[@]}")&& mv $(printf '%q ' "$out".tmp "$out")"
         else
-            echo -ne "  ⚠ $filename - repeating $i of $MAX_RETRIES - variance too high: ${variance} %\033[0K\r"
+            mkdir -p "${out%/*}" && "${compile[@]}" && mv "$out".tmp "$out"
         fi
+    fi
+    [[ $BUILD == "1" ]] && continue
+
+    echo -ne "  ⧗ $filename - sampling until CI ≤ ${CI_TARGET}% or ${TIME_BUDGET}s\033[0K\r"
+
+    # run benchmark: the program samples the kernel until the
+    # confidence interval of the median is narrow enough, or the
+    # time budget is exhausted
+    result=$(env "${size_env[@]}" "${run_env[@]}" POLYBENCH_REPS="$REPS" POLYBENCH_CI_TARGET="$CI_TARGET" \
+             POLYBENCH_TIME_BUDGET="$TIME_BUDGET" POLYBENCH_CACHE="$CACHE" \
+             POLYBENCH_ALLOC="$ALLOC" POLYBENCH_NUMA="$NUMA" /bin/sh ./utilities/time_benchmark.sh "$out")
+
+    result_arr=($result)            # split by whitespace
 
+    # binding applied by the OpenMP runtime, as reported by the first
+    # program; every program reports its own in its fields
+    if [[ -z $applied ]]; then
+        for field in "${result_arr[@]}"; do
+            [[ $field =~ ^(omp_threads|proc_bind|places|cpus)= ]] && applied+="$field "
+        done
+    fi
+
+    # measure the OpenMP runtime in a separate execution, so that the
+    # tool does not perturb the timing above
+    if [[ $OMPT == "1" ]]; then
+        echo -ne "  ⧗ $filename - measuring OpenMP runtime overhead\033[0K\r"
+        preload=""
+        if ldd "$out" | grep -q libgomp; then
+            if [ -z "$OMPT_RUNTIME" ]; then
+                echo "[ERROR]: $filename uses libgomp, which does not implement OMPT, and no libomp was found; set OMPT_RUNTIME to its path"
+                exit 1;
+            fi
+            preload="$OMPT_RUNTIME"
+        fi
+        ompt_result=$(env "${size_env[@]}" "${run_env[@]}" LD_PRELOAD="$preload" OMP_TOOL_LIBRARIES="$OMPT_TOOL" \
+                      POLYBENCH_REPS="$REPS" POLYBENCH_MAX_REPS="$REPS" \
+                      POLYBENCH_CACHE="$CACHE" POLYBENCH_ALLOC="$ALLOC" \
+                      POLYBENCH_NUMA="$NUMA" "$out" \
+                      | grep "^\[PolyBench\] ompt:" | sed 's/^\[PolyBench\] ompt://')
+        result_arr+=($ompt_result)
+    fi
+
+    # program, variance, time, timestamp, then reported key=value fields
+    res_n_time="$(printf '%s\t' "${result_arr[@]:0:3}")$(date '+%s')"
+    for field in "${result_arr[@]:3}"; do
+      res_n_time+=$'\t'"${field}"
     done
+
+    if test -f "$OUTFILE"; then
+      # remove previous result for this benchmark, if found
+      IFS=$'\n' read -d '' -r -a lines < "$OUTFILE"
+      for (( lineno=${#lines[@]}-1 ; lineno>=0 ; lineno-- )) ; do
+         if [[ "${lines[$lineno]}" = "$filename"* ]]; then
+            unset 'lines[lineno]'
+         fi
+      done
+      # append and write out
+      lines+=("${res_n_time}")
+      printf "%s\n" "${lines[@]}" > "$OUTFILE"
+    else
+      printf "%s\n" "${res_n_time}" > "$OUTFILE"
+    fi
+
+    # in a schedule, every result is also logged in run order, with the
+    # name of its results file, for speedups of samples run together
+    if [[ -n $SEED ]]; then
+        mkdir -p "$SCHED_DIR"
+        printf "%s\t%s\n" "$PATTERN" "${res_n_time}" >> ./"$SCHED_DIR"/seed_"$SEED".txt
+    fi
+
+    echo -e "\033[1;32m✓\033[0m ($(date '+%H:%M:%S')) done with ("$DS_SIZE", -"$OPT", "$SRC"): ${filename}\033[0K"
 done
 
+echo "# AFFINITY" >>  "$MODEL"
+echo "affinity applied: "${applied% }"" >>  "$MODEL"
+
 echo "# TIME" >>  "$MODEL"
 echo "start: "$START"" >>  "$MODEL"
 echo "end:   "$(date '+%H:%M:%S')"" >>  "$MODEL"
@@ -0,0 +1,114 @@
+#!/usr/bin/env bash
+
+# Checksum test of the shared initializers.
+#
+# The parallel initializers of headers/<program>_init.h must produce
+# the same data as the serial init_array of the unmodified benchmarks.
+# This script extracts that baseline from git (by default, the first
+# commit of the history), builds every program of both trees with
+# -DPOLYBENCH_DUMP_ARRAYS, and compares:
+#
+# - the dumped arrays of the baseline and of the tree, run on one
+#   thread (the kernels are the same; some of them race on more);
+# - the init_checksum of the tree (POLYBENCH_CHECKSUM=1) on one thread
+#   and on -t threads, which covers the initialized data directly.
+#
+# Any difference fails the test, except the intended ones listed in
+# INTENDED, which are reported: colormap computes its products on 64
+# bits, where the baseline's int products overflow from N = 46341 on
+# (SMALL and up), giving data that depended on the optimization level.
+# The default sizes and optimization levels include such a case.
+#
+# The initializers zeroing an output (bicg, gesummv, deriche) do not
+# change the dumps: the kernels overwrite it.
+#
+# basic usage:
+# ./utilities/check_init.sh -s "MINI SMALL" -o "O0 O2" -t 4
+
+
+# parse command line args
+while getopts b:c:d:s:o:t: flag
+do
+    case "${flag}" in
+        b) base=${OPTARG};;
+        c) compiler=${OPTARG};;
+        d) directories=${OPTARG};;
+        s) sizes=${OPTARG};;
+        o) opt_levels=${OPTARG};;
+        t) threads=${OPTARG};;
+        *) ;;
+    esac
+done
+
+CC="${compiler:-gcc}"                       # compiler, default: gcc
+DIRS=(${directories:-original fission alt}) # source directories
+SIZES=(${sizes:-MINI SMALL})                # data sizes
+OPTS=(${opt_levels:-O0 O2})                 # optimization levels
+THREADS=${threads:-4}                       # threads of the checksums
+
+# intended differences from the baseline: program, then the reason
+declare -A INTENDED=(
+    [colormap]="products on 64 bits, the baseline's int products overflow from N = 46341"
+)
+
+# the baseline: the unmodified benchmarks, first commit of the history
+BASE=${base:-$(git rev-list --max-parents=0 HEAD 2>/dev/null | tail -1)}
+if ! git rev-parse -q --verify "$BASE^{commit}" > /dev/null; then
+    echo "[ERROR]: cannot find the baseline commit $BASE; set it with -b"
+    exit 1;
+fi
+
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+mkdir -p "$TMP"/base "$TMP"/bin
+git archive "$BASE" | tar -x -C "$TMP"/base
+
+# build [tree] [dir] [prog] [opt] [size] [binary]
+build() {
+    (cd "$1" && "$CC" -"$4" -fopenmp -I utilities -I headers utilities/polybench.c "$2/$3.c" \
+         -DPOLYBENCH_TIME -DPOLYBENCH_DUMP_ARRAYS -D"$5"_DATASET -lm -o "$6")
+}
+
+failed=0
+for size in "${SIZES[@]}"; do
+    for opt in "${OPTS[@]}"; do
+        for dir in "${DIRS[@]}"; do
+            for file in ./"$dir"/*.c; do
+                prog=$(basename -- "$file" .c)
+                cell="$dir/$prog $size -$opt"
+                if [ ! -f "$TMP/base/$dir/$prog.c" ]; then
+                    echo "check-init: $cell skipped, not in the baseline"
+                    continue
+                fi
+                if ! build "$TMP"/base "$dir" "$prog" "$opt" "$size" "$TMP"/bin/base \
+                        || ! build . "$dir" "$prog" "$opt" "$size" "$TMP"/bin/tree; then
+                    echo "check-init: $cell FAILED to build"
+                    failed=1
+                    continue
+                fi
+                OMP_NUM_THREADS=1 "$TMP"/bin/base > /dev/null 2> "$TMP"/base.dump
+                sum1=$(OMP_NUM_THREADS=1 POLYBENCH_CHECKSUM=1 "$TMP"/bin/tree 2> "$TMP"/tree.dump \
+                       | grep init_checksum)
+                sumN=$(OMP_NUM_THREADS=$THREADS POLYBENCH_CHECKSUM=1 "$TMP"/bin/tree 2> /dev/null \
+                       | grep init_checksum)
+                if [[ -z $sum1 || $sum1 != "$sumN" ]]; then
+                    echo "check-init: $cell FAILED, checksums differ on 1 and $THREADS threads"
+                    failed=1
+                elif cmp -s "$TMP"/base.dump "$TMP"/tree.dump; then
+                    echo "check-init: $cell ok"
+                elif [ -n "${INTENDED[$prog]}" ]; then
+                    echo "check-init: $cell differs from the baseline, intended: ${INTENDED[$prog]}"
+                else
+                    echo "check-init: $cell FAILED, arrays differ from the baseline"
+                    failed=1
+                fi
+            done
+        done
+    done
+done
+
+if [[ $failed == "1" ]]; then
+    echo "check-init: initialized data differs, see above"
+    exit 1;
+fi
+echo "check-init: all initializers match the baseline, or differ as intended"
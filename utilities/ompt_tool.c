@@ -0,0 +1,371 @@
+/**
+ * ompt_tool.c: OpenMP runtime overhead of the benchmarks.
+ *
+ * OMPT tool measuring, for each program, the time spent by the OpenMP
+ * runtime rather than in the kernel: forking and joining parallel
+ * regions, waiting in implicit barriers, and idling between parallel
+ * regions on worker threads.
+ *
+ * Build as a shared library, and load it in an OMPT-capable runtime
+ * (e.g. LLVM libomp; GNU libgomp does not implement OMPT):
+ *
+ *   cc -shared -fPIC -O2 utilities/ompt_tool.c -o utilities/ompt_tool.so
+ *   OMP_TOOL_LIBRARIES=utilities/ompt_tool.so ./program
+ *
+ * Programs compiled with -DPOLYBENCH_OMPT call omp_control_tool to
+ * start and pause the measurement around each execution of the
+ * kernel; otherwise the whole execution is measured. Results are
+ * printed at exit, averaged per kernel execution, in seconds and
+ * summed over threads:
+ *
+ *   [PolyBench] ompt: ompt_windows=... ompt_regions=... ompt_fork=...
+ *     ompt_join=... ompt_barrier=... ompt_idle=... ompt_threads=...
+ *
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <omp-tools.h>
+
+#define OMPT_TOOL_MAX_THREADS 1024
+
+struct ompt_tool_counters
+{
+  double barrier;
+  double idle;
+  double fork;
+  double join;
+  unsigned long long regions;
+};
+
+/* Per-thread state. The counters and the end of the last implicit
+   task are only written by their own thread, and published with atomic
+   stores, as the master reads them while workers may still be in the
+   callbacks ending a region; the fork and join of a region go to its
+   encountering thread. The master never writes them: it keeps their
+   values at the start of the first window, and the idle time of the
+   workers parked when it closes a window, in fields of its own, on
+   another cache line. */
+struct ompt_tool_thread
+{
+  struct ompt_tool_counters c;
+  double task_end;		/* end of the last implicit task */
+  double barrier_begin;
+  int in_task;
+  char pad[64 - sizeof(struct ompt_tool_counters) - 2 * sizeof(double)
+	   - sizeof(int)];
+  struct ompt_tool_counters base;
+  double parked;
+};
+
+static struct ompt_tool_thread* ompt_tool_threads[OMPT_TOOL_MAX_THREADS];
+static int ompt_tool_nb_threads = 0;
+static ompt_get_thread_data_t ompt_get_thread_data_fn;
+
+/* Measurement window, opened and closed by the master between parallel
+   regions. */
+static int ompt_tool_active = 1;
+static int ompt_tool_windows = 0;
+static double ompt_tool_window_begin = 0;
+
+
+static
+double ompt_tool_clock()
+{
+  struct timespec Tp;
+  clock_gettime (CLOCK_MONOTONIC, &Tp);
+  return (Tp.tv_sec + Tp.tv_nsec * 1.0e-9);
+}
+
+
+static
+double ompt_tool_load(double* p)
+{
+  double v;
+  __atomic_load (p, &v, __ATOMIC_RELAXED);
+  return v;
+}
+
+
+/* Add d to a counter of the calling thread. */
+static
+void ompt_tool_add(double* p, double d)
+{
+  double v = *p + d;
+  __atomic_store (p, &v, __ATOMIC_RELAXED);
+}
+
+
+static
+int ompt_tool_is_active()
+{
+  return __atomic_load_n (&ompt_tool_active, __ATOMIC_RELAXED);
+}
+
+
+static
+int ompt_tool_threads_nb()
+{
+  int n = __atomic_load_n (&ompt_tool_nb_threads, __ATOMIC_RELAXED);
+  return n < OMPT_TOOL_MAX_THREADS ? n : OMPT_TOOL_MAX_THREADS;
+}
+
+
+static
+struct ompt_tool_thread* ompt_tool_thread_get(int i)
+{
+  return __atomic_load_n (&ompt_tool_threads[i], __ATOMIC_ACQUIRE);
+}
+
+
+static
+void on_thread_begin(ompt_thread_t type, ompt_data_t* thread_data)
+{
+  struct ompt_tool_thread* t = (struct ompt_tool_thread*)
+    calloc (1, sizeof(struct ompt_tool_thread));
+  int id = __atomic_fetch_add (&ompt_tool_nb_threads, 1, __ATOMIC_RELAXED);
+  if (t == NULL)
+    {
+      fprintf (stderr, "[PolyBench] ompt: not enough memory\n");
+      exit (1);
+    }
+  t->task_end = ompt_tool_clock ();
+  if (id < OMPT_TOOL_MAX_THREADS)
+    __atomic_store_n (&ompt_tool_threads[id], t, __ATOMIC_RELEASE);
+  thread_data->ptr = t;
+}
+
+
+static
+void on_parallel_begin(ompt_data_t* encountering_task_data,
+		       const ompt_frame_t* encountering_task_frame,
+		       ompt_data_t* parallel_data,
+		       unsigned int requested_parallelism,
+		       int flags, const void* codeptr_ra)
+{
+  /* Start time of the region, for the fork time of its first task. */
+  double now = ompt_tool_clock ();
+  memcpy (&parallel_data->value, &now, sizeof(double));
+}
+
+
+static
+void on_parallel_end(ompt_data_t* parallel_data,
+		     ompt_data_t* encountering_task_data,
+		     int flags, const void* codeptr_ra)
+{
+  struct ompt_tool_thread* t = (struct ompt_tool_thread*)
+    ompt_get_thread_data_fn ()->ptr;
+  double now = ompt_tool_clock ();
+  if (t == NULL || ! ompt_tool_is_active ())
+    return;
+  __atomic_store_n (&t->c.regions, t->c.regions + 1, __ATOMIC_RELAXED);
+  if (t->task_end > ompt_tool_window_begin)
+    ompt_tool_add (&t->c.join, now - t->task_end);
+}
+
+
+/* Fork: from the beginning of the parallel region to the start of the
+   encountering thread's implicit task. Join: from the end of that task
+   to the end of the region (parallel_data is not given at the end of
+   implicit tasks, so the task end is kept per thread). Idle: worker
+   time between two implicit tasks, within the measurement window. */
+static
+void on_implicit_task(ompt_scope_endpoint_t endpoint,
+		      ompt_data_t* parallel_data, ompt_data_t* task_data,
+		      unsigned int actual_parallelism, unsigned int index,
+		      int flags)
+{
+  struct ompt_tool_thread* t = (struct ompt_tool_thread*)
+    ompt_get_thread_data_fn ()->ptr;
+  double now = ompt_tool_clock ();
+
+  if (t == NULL || (flags & ompt_task_initial))
+    return;
+  if (endpoint == ompt_scope_begin)
+    {
+      __atomic_store_n (&t->in_task, 1, __ATOMIC_RELAXED);
+      if (! ompt_tool_is_active ())
+	return;
+      if (index == 0 && parallel_data != NULL)
+	{
+	  double begin;
+	  memcpy (&begin, &parallel_data->value, sizeof(double));
+	  ompt_tool_add (&t->c.fork, now - begin);
+	}
+      else if (index != 0)
+	{
+	  /* Idle until a pause is counted by the master, at the pause. */
+	  double from = t->task_end > ompt_tool_window_begin ?
+	    t->task_end : ompt_tool_window_begin;
+	  if (now > from)
+	    ompt_tool_add (&t->c.idle, now - from);
+	}
+    }
+  else
+    {
+      /* The task end, then in_task, for the master closing a window. */
+      __atomic_store (&t->task_end, &now, __ATOMIC_RELAXED);
+      __atomic_store_n (&t->in_task, 0, __ATOMIC_RELEASE);
+    }
+}
+
+
+static
+void on_sync_region(ompt_sync_region_t kind, ompt_scope_endpoint_t endpoint,
+		    ompt_data_t* parallel_data, ompt_data_t* task_data,
+		    const void* codeptr_ra)
+{
+  struct ompt_tool_thread* t = (struct ompt_tool_thread*)
+    ompt_get_thread_data_fn ()->ptr;
+
+  if (t == NULL
+      || (kind != ompt_sync_region_barrier_implicit
+	  && kind != ompt_sync_region_barrier_implicit_workshare
+	  && kind != ompt_sync_region_barrier_implicit_parallel
+	  && kind != ompt_sync_region_barrier))
+    return;
+  if (endpoint == ompt_scope_begin)
+    t->barrier_begin = ompt_tool_clock ();
+  else if (ompt_tool_is_active ())
+    ompt_tool_add (&t->c.barrier, ompt_tool_clock () - t->barrier_begin);
+}
+
+
+/* Counters of thread t since the start of the first window. */
+static
+struct ompt_tool_counters ompt_tool_read(struct ompt_tool_thread* t)
+{
+  struct ompt_tool_counters c;
+  c.barrier = ompt_tool_load (&t->c.barrier) - t->base.barrier;
+  c.idle = ompt_tool_load (&t->c.idle) - t->base.idle + t->parked;
+  c.fork = ompt_tool_load (&t->c.fork) - t->base.fork;
+  c.join = ompt_tool_load (&t->c.join) - t->base.join;
+  c.regions = __atomic_load_n (&t->c.regions, __ATOMIC_RELAXED)
+    - t->base.regions;
+  return c;
+}
+
+
+/* Discard what was measured before the first window: the master keeps
+   the counters' current values, to subtract them at the end. */
+static
+void ompt_tool_reset()
+{
+  int i, n = ompt_tool_threads_nb ();
+  for (i = 0; i < n; ++i)
+    {
+      struct ompt_tool_thread* t = ompt_tool_thread_get (i);
+      if (t == NULL)
+	continue;
+      t->base.barrier = ompt_tool_load (&t->c.barrier);
+      t->base.idle = ompt_tool_load (&t->c.idle);
+      t->base.fork = ompt_tool_load (&t->c.fork);
+      t->base.join = ompt_tool_load (&t->c.join);
+      t->base.regions = __atomic_load_n (&t->c.regions, __ATOMIC_RELAXED);
+      t->parked = 0;
+    }
+}
+
+
+/* omp_control_tool: start (1) opens a measurement window, pause (2)
+   closes it; the first window discards what was measured before. */
+static
+int on_control_tool(uint64_t command, uint64_t modifier, void* arg,
+		    const void* codeptr_ra)
+{
+  if (command == 1 && ! (ompt_tool_active && ompt_tool_windows > 0))
+    {
+      if (ompt_tool_windows == 0)
+	ompt_tool_reset ();
+      ompt_tool_windows++;
+      ompt_tool_window_begin = ompt_tool_clock ();
+      __atomic_store_n (&ompt_tool_active, 1, __ATOMIC_RELAXED);
+    }
+  else if (command == 2 && ompt_tool_active)
+    {
+      /* Workers are parked between regions: close their idle time, in
+	 the master's own field. A worker still ending its task is
+	 skipped; it was not idle yet. */
+      double now = ompt_tool_clock ();
+      int i, n = ompt_tool_threads_nb ();
+      __atomic_store_n (&ompt_tool_active, 0, __ATOMIC_RELAXED);
+      for (i = 1; i < n; ++i)
+	{
+	  struct ompt_tool_thread* t = ompt_tool_thread_get (i);
+	  double from;
+	  if (t == NULL || __atomic_load_n (&t->in_task, __ATOMIC_ACQUIRE))
+	    continue;
+	  from = ompt_tool_load (&t->task_end);
+	  if (from < ompt_tool_window_begin)
+	    from = ompt_tool_window_begin;
+	  if (now > from)
+	    t->parked += now - from;
+	}
+    }
+  return 0;
+}
+
+
+static
+int ompt_tool_initialize(ompt_function_lookup_t lookup,
+			 int initial_device_num, ompt_data_t* tool_data)
+{
+  ompt_set_callback_t set_callback =
+    (ompt_set_callback_t) lookup ("ompt_set_callback");
+  ompt_get_thread_data_fn =
+    (ompt_get_thread_data_t) lookup ("ompt_get_thread_data");
+  if (set_callback == NULL || ompt_get_thread_data_fn == NULL)
+    return 0;
+
+  set_callback (ompt_callback_thread_begin, (ompt_callback_t) on_thread_begin);
+  set_callback (ompt_callback_parallel_begin,
+		(ompt_callback_t) on_parallel_begin);
+  set_callback (ompt_callback_parallel_end, (ompt_callback_t) on_parallel_end);
+  set_callback (ompt_callback_implicit_task,
+		(ompt_callback_t) on_implicit_task);
+  set_callback (ompt_callback_sync_region, (ompt_callback_t) on_sync_region);
+  set_callback (ompt_callback_control_tool, (ompt_callback_t) on_control_tool);
+  ompt_tool_window_begin = ompt_tool_clock ();
+
+  return 1;
+}
+
+
+static
+void ompt_tool_finalize(ompt_data_t* tool_data)
+{
+  double barrier = 0, idle = 0, fork = 0, join = 0;
+  unsigned long long regions = 0;
+  int n = ompt_tool_windows > 0 ? ompt_tool_windows : 1;
+  int i;
+
+  for (i = 0; i < ompt_tool_threads_nb (); ++i)
+    if (ompt_tool_threads[i])
+      {
+	struct ompt_tool_counters c = ompt_tool_read (ompt_tool_threads[i]);
+	barrier += c.barrier;
+	idle += c.idle;
+	fork += c.fork;
+	join += c.join;
+	regions += c.regions;
+	free (ompt_tool_threads[i]);
+      }
+  printf ("[PolyBench] ompt: ompt_windows=%d ompt_regions=%llu "
+	  "ompt_fork=%0.9f ompt_join=%0.9f ompt_barrier=%0.9f "
+	  "ompt_idle=%0.9f ompt_threads=%d\n",
+	  ompt_tool_windows, regions / n, fork / n, join / n, barrier / n,
+	  idle / n, ompt_tool_nb_threads);
+  fflush (stdout);
+}
+
+
+ompt_start_tool_result_t* ompt_start_tool(unsigned int omp_version,
+					  const char* runtime_version)
+{
+  static ompt_start_tool_result_t result = {
+    ompt_tool_initialize, ompt_tool_finalize, { 0 }
+  };
+  return &result;
+}
@@ -12,12 +12,20 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stdarg.h>
 #include <unistd.h>
 #include <assert.h>
 #include <time.h>
 #include <sys/time.h>
 #include <sys/resource.h>
 #include <sched.h>
+#include <sys/mman.h>
+#ifdef __linux__
+# include <sys/syscall.h>
+# include <linux/mempolicy.h>
+#endif
+#include <fcntl.h>
+#include <sys/stat.h>
 #include <math.h>
 #ifdef _OPENMP
 # include <omp.h>
@@ -30,14 +38,65 @@
 # define POLYBENCH_THREAD_MONITOR 0
 #endif
 
-/* Total LLC cache size. By default 32+MB.. */
+/* Page policy of the arrays: 4k, thp, 2m or 1g. See xmalloc. */
+#ifndef POLYBENCH_ALLOC_POLICY
+# define POLYBENCH_ALLOC_POLICY 4k
+#endif
+#define POLYBENCH_STR(x) #x
+#define POLYBENCH_XSTR(x) POLYBENCH_STR(x)
+
+/* Arena allocation of the arrays: on with -DPOLYBENCH_ARENA or
+   POLYBENCH_ARENA=1. Each array starts on a POLYBENCH_ARENA_ALIGN byte
+   boundary, shifted by k * POLYBENCH_ARENA_OFFSET bytes for the k-th
+   array (both overridden by the environment variables of the same
+   name). POLYBENCH_ARENA_RESERVE_MB of address space are reserved. */
+#ifndef POLYBENCH_ARENA_ALIGN
+# define POLYBENCH_ARENA_ALIGN 4096
+#endif
+#ifndef POLYBENCH_ARENA_OFFSET
+# define POLYBENCH_ARENA_OFFSET 0
+#endif
+#ifndef POLYBENCH_ARENA_RESERVE_MB
+# define POLYBENCH_ARENA_RESERVE_MB (1 << 20)
+#endif
+
+/* Version of the dataset cache files; increase it when an init_array
+   changes, so that files of older versions are not loaded. */
+#ifndef POLYBENCH_DATASET_VERSION
+# define POLYBENCH_DATASET_VERSION 5
+#endif
+
+/* Size of the cache flush buffer, when the cache sizes cannot be read
+   from sysfs. By default 32+MB.. */
 #ifndef POLYBENCH_CACHE_SIZE_KB
 # define POLYBENCH_CACHE_SIZE_KB 32770
 #endif
 
+/* Repetition engine: number of measured and of warm-up (discarded)
+   kernel executions. Overridden at run time by the environment
+   variables POLYBENCH_REPS and POLYBENCH_WARMUP. */
+#ifndef POLYBENCH_REPEAT_COUNT
+# define POLYBENCH_REPEAT_COUNT 5
+#endif
+#ifndef POLYBENCH_REPEAT_WARMUP
+# define POLYBENCH_REPEAT_WARMUP 1
+#endif
+/* Upper bound on measured executions when sampling until a target
+   confidence interval is reached. Overridden by POLYBENCH_MAX_REPS. */
+#ifndef POLYBENCH_REPEAT_MAX
+# define POLYBENCH_REPEAT_MAX 1000
+#endif
+
+/* Events kept per thread by the region tracer; the environment
+   variable POLYBENCH_TRACE_EVENTS overrides it. */
+#ifndef POLYBENCH_TRACE_EVENTS
+# define POLYBENCH_TRACE_EVENTS 65536
+#endif
+
 
 int polybench_papi_counters_threadid = POLYBENCH_THREAD_MONITOR;
 double polybench_program_total_flops = 0;
+double polybench_program_total_bytes = 0;
 
 #ifdef POLYBENCH_PAPI
 # include <papi.h>
@@ -52,31 +111,131 @@ double polybench_program_total_flops = 0;
 
 #endif
 
+#ifdef POLYBENCH_OMPT
+/* OpenMP 5.0, not declared by every omp.h; weak so that programs still
+   link with runtimes that do not provide it. */
+extern int omp_control_tool(int command, int modifier, void* arg)
+  __attribute__((weak));
+# define POLYBENCH_OMPT_START 1
+# define POLYBENCH_OMPT_PAUSE 2
+# define polybench_ompt_control(command) \
+  if (omp_control_tool) omp_control_tool (command, 0, NULL)
+#endif
+
+#ifdef POLYBENCH_PERF
+# include <sys/ioctl.h>
+# include <linux/perf_event.h>
+/* Counters of the perf_event_open backend, read as a single group. */
+struct polybench_perf_event
+{
+  const char* name;
+  unsigned int type;
+  unsigned long long config;
+};
+static const struct polybench_perf_event polybench_perf_events[] = {
+  { "cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+  { "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+  { "llc_loads", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL
+    | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+    | (PERF_COUNT_HW_CACHE_RESULT_ACCESS << 16) },
+  { "llc_misses", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL
+    | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+    | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+  { "dtlb_misses", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB
+    | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+    | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+  { "branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+};
+# define POLYBENCH_NB_PERF_EVENTS \
+  (sizeof(polybench_perf_events) / sizeof(polybench_perf_events[0]))
+/* One group per OpenMP thread; event i of thread t is at
+   [t * POLYBENCH_NB_PERF_EVENTS + i]. */
+static int polybench_perf_nb_threads = 0;
+static int* polybench_perf_fd = NULL;
+static unsigned long long* polybench_perf_values = NULL;
+static unsigned long long* polybench_perf_time_enabled = NULL;
+static unsigned long long* polybench_perf_time_running = NULL;
+#endif
+
 /*
- * Allocation table, to enable inter-array padding. All data allocated
- * with polybench_alloc_data should be freed with polybench_free_data.
+ * Inter-array padding. All data allocated with polybench_alloc_data
+ * should be freed with polybench_free_data, which finds the original,
+ * non-shifted pointer in the data registry.
  *
  */
 #define NB_INITIAL_TABLE_ENTRIES 512
-struct polybench_data_ptrs
+static size_t polybench_inter_array_padding_sz = 0;
+
+/*
+ * Data registry. Keeps track of every array allocated with
+ * polybench_alloc_data (user view and size), so that the benchmark
+ * data can be inspected as a whole, e.g. to snapshot and restore the
+ * initialized arrays between repetitions.
+ *
+ */
+#define POLYBENCH_MAX_DIMS 5
+
+struct polybench_data_entry
 {
-  void** user_view;
-  void** real_ptr;
-  int nb_entries;
-  int nb_avail_entries;
+  void* ptr;
+  size_t sz;
+  void* snapshot;
+  /* Underlying allocation: start, size, and kind of pages. */
+  void* base;
+  size_t map_sz;
+  int pages;
+  /* Dimensions, padding included, when allocated by
+     polybench_alloc_array; nb_dims is 0 otherwise. */
+  int nb_dims;
+  unsigned long long dims[POLYBENCH_MAX_DIMS];
 };
-static struct polybench_data_ptrs* _polybench_alloc_table = NULL;
-static size_t polybench_inter_array_padding_sz = 0;
+static struct polybench_data_entry* _polybench_data_registry = NULL;
+static int polybench_data_registry_nb = 0;
+static int polybench_data_registry_avail = 0;
+/* Index of the registry, by user pointer: open addressing with linear
+   probing; slots hold a registry position plus one, 0 when empty. The
+   table is kept at most half full. */
+static int* polybench_data_index = NULL;
+static size_t polybench_data_index_sz = 0;
 
-/* Timer code (gettimeofday). */
+/* Timer code (gettimeofday, or clock_gettime). */
 double polybench_t_start, polybench_t_end;
 /* Timer code (RDTSC). */
 unsigned long long int polybench_c_start, polybench_c_end;
+#ifndef POLYBENCH_CYCLE_ACCURATE_TIMER
+/* Cost of one timer read, subtracted from measured times. */
+static double polybench_timer_overhead = -1;
+#endif
+
+/* Printf format of the measured times, in seconds. */
+#if defined(POLYBENCH_MONOTONIC_TIMER) || defined(POLYBENCH_CYCLE_ACCURATE_TIMER)
+# define POLYBENCH_TIME_FMT "%0.9f"
+#else
+# define POLYBENCH_TIME_FMT "%0.6f"
+#endif
+
+/* Linux-specific clock, not adjusted by NTP. */
+#ifdef CLOCK_MONOTONIC_RAW
+# define POLYBENCH_CLOCK_ID CLOCK_MONOTONIC_RAW
+# define POLYBENCH_CLOCK_NAME "monotonic_raw"
+#else
+# define POLYBENCH_CLOCK_ID CLOCK_MONOTONIC
+# define POLYBENCH_CLOCK_NAME "monotonic"
+#endif
 
+/* Wall clock; with the TSC, only the time budget of repetitions. */
+#if !defined(POLYBENCH_CYCLE_ACCURATE_TIMER) || defined(POLYBENCH_REPEAT)
 static
 double rtclock()
 {
-#if defined(POLYBENCH_TIME) || defined(POLYBENCH_GFLOPS)
+#if defined(POLYBENCH_MONOTONIC_TIMER) && (defined(POLYBENCH_TIME) || defined(POLYBENCH_GFLOPS))
+    struct timespec Tp;
+    int stat;
+    stat = clock_gettime (POLYBENCH_CLOCK_ID, &Tp);
+    if (stat != 0)
+      printf ("Error return from clock_gettime: %d", stat);
+    return (Tp.tv_sec + Tp.tv_nsec * 1.0e-9);
+#elif defined(POLYBENCH_TIME) || defined(POLYBENCH_GFLOPS)
     struct timeval Tp;
     int stat;
     stat = gettimeofday (&Tp, NULL);
@@ -87,35 +246,438 @@ double rtclock()
     return 0;
 #endif
 }
+#endif
+
+
+#ifdef POLYBENCH_MONOTONIC_TIMER
+/* Measure the overhead of a timer read: the smallest difference
+   between back-to-back reads. */
+static
+void polybench_timer_calibrate()
+{
+  int k;
+  double t1, t2, best = 1.0;
+  for (k = 0; k < 1000; k++)
+    {
+      t1 = rtclock ();
+      t2 = rtclock ();
+      if (t2 - t1 < best)
+	best = t2 - t1;
+    }
+  polybench_timer_overhead = best;
+}
+#endif
 
 
 #ifdef POLYBENCH_CYCLE_ACCURATE_TIMER
+# include <cpuid.h>
+/* TSC frequency, invariance, RDTSCP support, and cost of a read. */
+static double polybench_tsc_hz = 0;
+static int polybench_tsc_invariant = 0;
+static int polybench_tsc_rdtscp = 0;
+static unsigned long long int polybench_tsc_overhead = 0;
+
+/* Start of a timed region: LFENCE waits for prior instructions to
+   complete, and the trailing LFENCE keeps the region from starting
+   before the TSC is read. */
 static
 unsigned long long int rdtsc()
 {
   unsigned long long int ret = 0;
   unsigned int cycles_lo;
   unsigned int cycles_hi;
-  __asm__ volatile ("RDTSC" : "=a" (cycles_lo), "=d" (cycles_hi));
+  __asm__ volatile ("lfence\n\trdtsc\n\tlfence"
+		    : "=a" (cycles_lo), "=d" (cycles_hi) : : "memory");
+  ret = (unsigned long long int)cycles_hi << 32 | cycles_lo;
+
+  return ret;
+}
+
+/* End of a timed region: RDTSCP waits for prior instructions to
+   complete; the LFENCE keeps later instructions from starting
+   before the TSC is read. */
+static
+unsigned long long int rdtscp()
+{
+  unsigned long long int ret = 0;
+  unsigned int cycles_lo;
+  unsigned int cycles_hi;
+  unsigned int aux;
+  if (! polybench_tsc_rdtscp)
+    return rdtsc ();
+  __asm__ volatile ("rdtscp\n\tlfence"
+		    : "=a" (cycles_lo), "=d" (cycles_hi), "=c" (aux) : : "memory");
   ret = (unsigned long long int)cycles_hi << 32 | cycles_lo;
 
   return ret;
 }
+
+static
+double monotonic_seconds()
+{
+  struct timespec Tp;
+  clock_gettime (POLYBENCH_CLOCK_ID, &Tp);
+  return (Tp.tv_sec + Tp.tv_nsec * 1.0e-9);
+}
+
+/* Detect RDTSCP and invariant TSC (CPUID 0x80000001 EDX[27] and
+   0x80000007 EDX[8]), then measure the TSC frequency against the
+   monotonic clock (median of 3 spins of 20 ms), and the cost of a
+   begin/end pair of reads. */
+static
+void polybench_tsc_calibrate()
+{
+  unsigned int eax, ebx, ecx, edx;
+  double hz[3], tmp;
+  int k;
+
+  if (__get_cpuid (0x80000001, &eax, &ebx, &ecx, &edx))
+    polybench_tsc_rdtscp = (edx >> 27) & 1;
+  if (__get_cpuid (0x80000007, &eax, &ebx, &ecx, &edx))
+    polybench_tsc_invariant = (edx >> 8) & 1;
+  if (! polybench_tsc_invariant)
+    printf ("[PolyBench][WARNING] TSC is not invariant, cycles may not convert to time\n");
+
+  for (k = 0; k < 3; k++)
+    {
+      double t0 = monotonic_seconds (), t1;
+      unsigned long long int c0 = rdtsc (), c1;
+      do
+	t1 = monotonic_seconds ();
+      while (t1 - t0 < 0.02);
+      c1 = rdtscp ();
+      hz[k] = (c1 - c0) / (t1 - t0);
+    }
+  if (hz[0] > hz[1]) { tmp = hz[0]; hz[0] = hz[1]; hz[1] = tmp; }
+  if (hz[1] > hz[2]) { tmp = hz[1]; hz[1] = hz[2]; hz[2] = tmp; }
+  if (hz[0] > hz[1]) { tmp = hz[0]; hz[0] = hz[1]; hz[1] = tmp; }
+  polybench_tsc_hz = hz[1];
+
+  polybench_tsc_overhead = ~0ULL;
+  for (k = 0; k < 1000; k++)
+    {
+      unsigned long long int c0 = rdtsc ();
+      unsigned long long int c1 = rdtscp ();
+      if (c1 - c0 < polybench_tsc_overhead)
+	polybench_tsc_overhead = c1 - c0;
+    }
+}
+
+/* Cycles of the last timed region, minus the cost of the reads. */
+static
+unsigned long long int polybench_timer_cycles()
+{
+  unsigned long long int c = polybench_c_end - polybench_c_start;
+  return c > polybench_tsc_overhead ? c - polybench_tsc_overhead : 0;
+}
 #endif
 
-void polybench_flush_cache()
+/* Read a non-negative integer setting from the environment. */
+static
+int polybench_env_int(const char* name, int def)
+{
+  char* val = getenv (name);
+  if (val == NULL || *val == '\0')
+    return def;
+  int ret = atoi (val);
+  return ret >= 0 ? ret : def;
+}
+
+
+#ifdef POLYBENCH_DYNAMIC_SIZES
+/*
+ * Run-time problem sizes. The command line is saved by a constructor
+ * of higher priority than the size initializers of the benchmark
+ * (glibc passes argc and argv to constructors), which then look up
+ * NAME=value arguments, then POLYBENCH_SIZE_NAME in the environment.
+ * The sizes obtained are reported with the timing.
+ *
+ */
+#define POLYBENCH_MAX_SIZES 16
+static int polybench_argc = 0;
+static char** polybench_argv = NULL;
+static const char* polybench_size_names[POLYBENCH_MAX_SIZES];
+static long long polybench_size_values[POLYBENCH_MAX_SIZES];
+static int polybench_nb_sizes = 0;
+
+__attribute__((constructor(101)))
+static
+void polybench_save_args(int argc, char** argv)
+{
+  polybench_argc = argc;
+  polybench_argv = argv;
+}
+
+
+long long polybench_dynamic_size(const char* name, long long def,
+				 int index_size)
+{
+  size_t len = strlen (name);
+  const char* val = NULL;
+  char var[64];
+  int i;
+
+  for (i = 1; i < polybench_argc; ++i)
+    if (strncmp (polybench_argv[i], name, len) == 0
+	&& polybench_argv[i][len] == '=')
+      val = polybench_argv[i] + len + 1;
+  if (val == NULL)
+    {
+      snprintf (var, sizeof(var), "POLYBENCH_SIZE_%s", name);
+      val = getenv (var);
+    }
+  if (val != NULL && *val != '\0')
+    {
+      char* end;
+      def = strtoll (val, &end, 10);
+      if (*end != '\0' || def <= 0)
+	{
+	  fprintf (stderr, "[PolyBench] invalid size %s=%s\n", name, val);
+	  exit (1);
+	}
+    }
+  if (index_size < (int) sizeof(long long)
+      && def > (1LL << (8 * index_size - 1)) - 1)
+    {
+      fprintf (stderr, "[PolyBench] size %s=%lld exceeds the index type,"
+	       " compile with -DPOLYBENCH_USE_LONG_INDEX\n", name, def);
+      exit (1);
+    }
+  if (polybench_nb_sizes < POLYBENCH_MAX_SIZES)
+    {
+      polybench_size_names[polybench_nb_sizes] = name;
+      polybench_size_values[polybench_nb_sizes++] = def;
+    }
+
+  return def;
+}
+
+
+static
+void polybench_sizes_print_info()
 {
-  int cs = POLYBENCH_CACHE_SIZE_KB * 1024 / sizeof(double);
-  double* flush = (double*) calloc (cs, sizeof(double));
   int i;
+  if (polybench_nb_sizes == 0)
+    return;
+  printf ("[PolyBench] sizes:");
+  for (i = 0; i < polybench_nb_sizes; ++i)
+    printf (" %s=%lld", polybench_size_names[i], polybench_size_values[i]);
+  printf ("\n");
+}
+#endif
+
+
+/* Size in KB of the largest data or unified cache, times the number of
+   its instances (one per socket, or per core complex), read from sysfs;
+   0 if unavailable. */
+static
+long polybench_llc_size_kb()
+{
+  char path[128], buf[256], key[260];
+  char* seen = NULL;
+  size_t seen_len = 0;
+  int level, best_level = 0, cpu, idx;
+  long size, best = 0, total = 0;
+  FILE* f;
+
+  for (cpu = 0; ; cpu++)
+    {
+      snprintf (path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache", cpu);
+      if (access (path, F_OK) != 0)
+	break;
+      for (idx = 0; ; idx++)
+	{
+#define POLYBENCH_READ_CACHE_ATTR(attr)					\
+	  snprintf (path, sizeof(path),					\
+		    "/sys/devices/system/cpu/cpu%d/cache/index%d/" attr, cpu, idx); \
+	  if ((f = fopen (path, "r")) == NULL)				\
+	    break;							\
+	  if (fgets (buf, sizeof(buf), f) == NULL)			\
+	    buf[0] = '\0';						\
+	  fclose (f);
+	  POLYBENCH_READ_CACHE_ATTR("type");
+	  if (strncmp (buf, "Instruction", 11) == 0)
+	    continue;
+	  POLYBENCH_READ_CACHE_ATTR("level");
+	  level = atoi (buf);
+	  POLYBENCH_READ_CACHE_ATTR("size");
+	  size = atol (buf);
+	  if (strchr (buf, 'M'))
+	    size *= 1024;
+	  POLYBENCH_READ_CACHE_ATTR("shared_cpu_list");
+#undef POLYBENCH_READ_CACHE_ATTR
+	  if (level < best_level)
+	    continue;
+	  if (level > best_level)
+	    {
+	      best_level = level;
+	      best = size;
+	      total = 0;
+	      seen_len = 0;
+	    }
+	  /* Count each instance once, by its list of sharing CPUs; seen
+	     holds ";list;list;...;". */
+	  buf[strcspn (buf, "\n")] = '\0';
+	  snprintf (key, sizeof(key), ";%s;", buf);
+	  if (seen_len > 0 && strstr (seen, key))
+	    continue;
+	  seen = (char*) realloc (seen, seen_len + strlen (key) + 1);
+	  if (seen == NULL)
+	    return 0;
+	  memcpy (seen + seen_len, key, strlen (key) + 1);
+	  seen_len += strlen (key) - 1;
+	  total += best;
+	}
+    }
+  free (seen);
+
+  return total;
+}
+
+
+/* Cache flush. By default, a buffer twice the size of all last-level
+   caches is read by all threads, which also evicts their private
+   caches; it is written once when allocated, so that it is backed by
+   real pages (calloc'd memory may map the shared zero page, which is
+   never cached). With POLYBENCH_FLUSH=clflush, the lines of all data
+   allocated with polybench_alloc_data are instead flushed from every
+   cache of the coherence domain (x86 only). */
+static double* polybench_flush_buffer = NULL;
+static size_t polybench_flush_size = 0;
+
+static
+void polybench_flush_buffer_init()
+{
+  long kb = polybench_env_int ("POLYBENCH_CACHE_SIZE_KB", 0);
+  size_t i, n;
+  if (kb == 0)
+    kb = 2 * polybench_llc_size_kb ();
+  if (kb == 0)
+    kb = POLYBENCH_CACHE_SIZE_KB;
+  n = (size_t) kb * 1024 / sizeof(double);
+  polybench_flush_buffer = (double*) malloc (n * sizeof(double));
+  if (polybench_flush_buffer == NULL)
+    {
+      fprintf (stderr, "[PolyBench] Not enough memory for the cache flush\n");
+      exit (1);
+    }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (i = 0; i < n; i++)
+    polybench_flush_buffer[i] = 1.0;
+  polybench_flush_size = n;
+}
+
+
+#if defined(__x86_64__) || defined(__i386__)
+static
+void polybench_clflush_range(void* ptr, size_t sz, int opt)
+{
+  char* p = (char*) ((size_t) ptr & ~(size_t) 63);
+  char* end = (char*) ptr + sz;
+  if (opt)
+    for (; p < end; p += 64)
+      __asm__ volatile ("clflushopt %0" : "+m" (*(volatile char*) p));
+  else
+    for (; p < end; p += 64)
+      __asm__ volatile ("clflush %0" : "+m" (*(volatile char*) p));
+}
+#endif
+
+
+static
+int polybench_flush_use_clflush()
+{
+  static int mode = -1;
+  if (mode == -1)
+    {
+      char* val = getenv ("POLYBENCH_FLUSH");
+      mode = val != NULL && strcmp (val, "clflush") == 0;
+#if !defined(__x86_64__) && !defined(__i386__)
+      if (mode)
+	printf ("[PolyBench][WARNING] clflush is x86 only, using a buffer\n");
+      mode = 0;
+#endif
+    }
+  return mode;
+}
+
+
+void polybench_flush_cache()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  if (polybench_flush_use_clflush ())
+    {
+      /* CLFLUSHOPT: CPUID.(EAX=7,ECX=0):EBX[23]. */
+      unsigned int eax, ebx = 0, ecx, edx;
+      int i;
+      __asm__ volatile ("cpuid" : "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx)
+			: "a" (7), "c" (0));
+      for (i = 0; i < polybench_data_registry_nb; ++i)
+	{
+	  struct polybench_data_entry* e = &_polybench_data_registry[i];
+	  polybench_clflush_range (e->ptr, e->sz, (ebx >> 23) & 1);
+	  if (e->snapshot)
+	    polybench_clflush_range (e->snapshot, e->sz, (ebx >> 23) & 1);
+	}
+      __asm__ volatile ("mfence" ::: "memory");
+      return;
+    }
+#endif
+
+  if (polybench_flush_buffer == NULL)
+    polybench_flush_buffer_init ();
+  size_t i, n = polybench_flush_size;
   double tmp = 0.0;
 #ifdef _OPENMP
-#pragma omp parallel for reduction(+:tmp) private(i)
+#pragma omp parallel for schedule(static) reduction(+:tmp)
+#endif
+  for (i = 0; i < n; i += 8)
+    tmp += polybench_flush_buffer[i];
+  assert (tmp <= n);
+}
+
+
+/* Cache state of the timed regions: cold (caches flushed before each
+   of them, the default) or warm (not flushed, as with
+   -DPOLYBENCH_NO_FLUSH_CACHE). The environment variable
+   POLYBENCH_CACHE=warm|cold overrides the compiled default. */
+static
+int polybench_cache_warm()
+{
+  static int warm = -1;
+  if (warm == -1)
+    {
+      char* val = getenv ("POLYBENCH_CACHE");
+#ifdef POLYBENCH_NO_FLUSH_CACHE
+      warm = 1;
+#else
+      warm = 0;
 #endif
-  for (i = 0; i < cs; i++)
-    tmp += flush[i];
-  assert (tmp <= 10.0);
-  free (flush);
+      if (val != NULL && strcmp (val, "warm") == 0)
+	warm = 1;
+      else if (val != NULL && strcmp (val, "cold") == 0)
+	warm = 0;
+      else if (val != NULL && *val != '\0')
+	printf ("[PolyBench][WARNING] POLYBENCH_CACHE=%s, expected warm or cold\n",
+		val);
+    }
+  return warm;
+}
+
+
+/* Report the cache state, and how the caches are flushed. */
+static
+void polybench_flush_print_info()
+{
+  if (polybench_cache_warm ())
+    printf ("[PolyBench] cache: cache=warm\n");
+  else if (polybench_flush_use_clflush ())
+    printf ("[PolyBench] cache: cache=cold flush=clflush\n");
+  else
+    printf ("[PolyBench] cache: cache=cold flush=buffer flush_size_kb=%lu\n",
+	    (unsigned long) (polybench_flush_size * sizeof(double) / 1024));
 }
 
 
@@ -241,9 +803,8 @@ void polybench_papi_close()
 
 int polybench_papi_start_counter(int evid)
 {
-# ifndef POLYBENCH_NO_FLUSH_CACHE
-    polybench_flush_cache();
-# endif
+  if (! polybench_cache_warm ())
+    polybench_flush_cache ();
 
 # ifdef _OPENMP
 # pragma omp parallel
@@ -339,194 +900,1510 @@ void polybench_papi_print()
 #endif
 /* ! POLYBENCH_PAPI */
 
-void polybench_prepare_instruments()
-{
-#ifndef POLYBENCH_NO_FLUSH_CACHE
-  polybench_flush_cache ();
-#endif
-#ifdef POLYBENCH_LINUX_FIFO_SCHEDULER
-  polybench_linux_fifo_scheduler ();
-#endif
-}
-
-
-void polybench_timer_start()
-{
-  polybench_prepare_instruments ();
-#ifndef POLYBENCH_CYCLE_ACCURATE_TIMER
-  polybench_t_start = rtclock ();
-#else
-  polybench_c_start = rdtsc ();
-#endif
-}
-
+#ifdef POLYBENCH_PERF
 
-void polybench_timer_stop()
+static
+int perf_event_open(struct perf_event_attr* attr, int group_fd)
 {
-#ifndef POLYBENCH_CYCLE_ACCURATE_TIMER
-  polybench_t_end = rtclock ();
-#else
-  polybench_c_end = rdtsc ();
-#endif
-#ifdef POLYBENCH_LINUX_FIFO_SCHEDULER
-  polybench_linux_standard_scheduler ();
-#endif
+  /* Calling thread, any CPU. */
+  return syscall (SYS_perf_event_open, attr, 0, -1, group_fd, 0);
 }
 
 
-void polybench_timer_print()
-{
-#ifdef POLYBENCH_GFLOPS
-      if  (polybench_program_total_flops == 0)
-	{
-	  printf ("[PolyBench][WARNING] Program flops not defined, use polybench_set_program_flops(value)\n");
-	  printf ("%0.6lf\n", polybench_t_end - polybench_t_start);
-	}
-      else
-	printf ("%0.2lf\n",
-		(polybench_program_total_flops /
-		 (double)(polybench_t_end - polybench_t_start)) / 1000000000);
-#else
-# ifndef POLYBENCH_CYCLE_ACCURATE_TIMER
-      printf ("%0.6f\n", polybench_t_end - polybench_t_start);
-# else
-      printf ("%Ld\n", polybench_c_end - polybench_c_start);
-# endif
-#endif
-}
-
-/*
- * These functions are used only if the user defines a specific
- * inter-array padding. It grows a global structure,
- * _polybench_alloc_table, which keeps track of the data allocated via
- * polybench_alloc_data (on which inter-array padding is applied), so
- * that the original, non-shifted pointer can be recovered when
- * calling polybench_free_data.
- *
- */
-#ifdef POLYBENCH_ENABLE_INTARRAY_PAD
+/* Open all counters of the calling thread as one group, led by the
+   first event that can be opened; unsupported events are skipped. */
 static
-void grow_alloc_table()
+int polybench_perf_open(int* fd, int verbose)
 {
-  if (_polybench_alloc_table == NULL ||
-      (_polybench_alloc_table->nb_entries % NB_INITIAL_TABLE_ENTRIES) != 0 ||
-      _polybench_alloc_table->nb_avail_entries != 0)
+  struct perf_event_attr attr;
+  int leader = -1;
+  unsigned int i;
+
+  for (i = 0; i < POLYBENCH_NB_PERF_EVENTS; ++i)
     {
-      /* Should never happen if the API is properly used. */
-      fprintf (stderr, "[ERROR] Inter-array padding requires to use polybench_alloc_data and polybench_free_data\n");
-      exit (1);
+      memset (&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = polybench_perf_events[i].type;
+      attr.config = polybench_perf_events[i].config;
+      attr.disabled = (leader == -1);
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID
+	| PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      fd[i] = perf_event_open (&attr, leader);
+      if (fd[i] == -1 && verbose)
+	printf ("[PolyBench][WARNING] perf event %s unavailable\n",
+		polybench_perf_events[i].name);
+      else if (fd[i] != -1 && leader == -1)
+	leader = fd[i];
     }
-  size_t sz = _polybench_alloc_table->nb_entries;
-  sz += NB_INITIAL_TABLE_ENTRIES;
-  _polybench_alloc_table->user_view =
-    realloc (_polybench_alloc_table->user_view, sz * sizeof(void*));
-  assert(_polybench_alloc_table->user_view != NULL);
-  _polybench_alloc_table->real_ptr =
-    realloc (_polybench_alloc_table->real_ptr, sz * sizeof(void*));
-  assert(_polybench_alloc_table->real_ptr != NULL);
-  _polybench_alloc_table->nb_avail_entries = NB_INITIAL_TABLE_ENTRIES;
+
+  return leader;
 }
 
+
+/* Each thread of the OpenMP team opens its own group, as counters
+   follow the thread that opened them; the runtime reuses the same
+   threads for the parallel regions of the kernel. The team may have
+   fewer threads than requested (OMP_DYNAMIC, thread limits): the slots
+   of missing threads keep fd -1, and are skipped. */
 static
-void* register_padded_pointer(void* ptr, size_t orig_sz, size_t padded_sz)
+void polybench_perf_init()
 {
-  if (_polybench_alloc_table == NULL)
+  size_t i;
+  int nb = 1;
+#ifdef _OPENMP
+  nb = omp_get_max_threads ();
+#endif
+  polybench_perf_nb_threads = nb;
+  polybench_perf_fd = (int*) calloc (nb * POLYBENCH_NB_PERF_EVENTS, sizeof(int));
+  polybench_perf_values = (unsigned long long*)
+    calloc (nb * POLYBENCH_NB_PERF_EVENTS, sizeof(unsigned long long));
+  polybench_perf_time_enabled = (unsigned long long*)
+    calloc (nb, sizeof(unsigned long long));
+  polybench_perf_time_running = (unsigned long long*)
+    calloc (nb, sizeof(unsigned long long));
+  if (! polybench_perf_fd || ! polybench_perf_values
+      || ! polybench_perf_time_enabled || ! polybench_perf_time_running)
     {
-      fprintf (stderr, "[ERROR] Inter-array padding requires to use polybench_alloc_data and polybench_free_data\n");
+      fprintf (stderr, "[PolyBench] Not enough memory for perf counters\n");
       exit (1);
     }
-  if (_polybench_alloc_table->nb_avail_entries == 0)
-    grow_alloc_table ();
-  int id = _polybench_alloc_table->nb_entries++;
-  _polybench_alloc_table->real_ptr[id] = ptr;
-  _polybench_alloc_table->user_view[id] = ptr + (padded_sz - orig_sz);
-
-  return _polybench_alloc_table->user_view[id];
-}
+  for (i = 0; i < nb * POLYBENCH_NB_PERF_EVENTS; ++i)
+    polybench_perf_fd[i] = -1;
 
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nb)
+#endif
+  {
+    int t = 0;
+#ifdef _OPENMP
+    t = omp_get_thread_num ();
+#endif
+    polybench_perf_open (polybench_perf_fd + t * POLYBENCH_NB_PERF_EVENTS,
+			 t == 0);
+  }
 
-static
-void
-free_data_from_alloc_table (void* ptr)
-{
-  if (_polybench_alloc_table != NULL && _polybench_alloc_table->nb_entries > 0)
+  if (polybench_perf_fd[0] < 0)
     {
-      int i;
-      for (i = 0; i < _polybench_alloc_table->nb_entries; ++i)
-	if (_polybench_alloc_table->user_view[i] == ptr ||
-	    _polybench_alloc_table->real_ptr[i] == ptr)
-	  break;
-      if (i != _polybench_alloc_table->nb_entries)
+      for (i = 1; i < POLYBENCH_NB_PERF_EVENTS && polybench_perf_fd[i] < 0; ++i)
+	;
+      if (i == POLYBENCH_NB_PERF_EVENTS)
 	{
-	  free (_polybench_alloc_table->real_ptr[i]);
-	  for (; i < _polybench_alloc_table->nb_entries - 1; ++i)
-	    {
-	      _polybench_alloc_table->user_view[i] =
-		_polybench_alloc_table->user_view[i + 1];
-	      _polybench_alloc_table->real_ptr[i] =
-		_polybench_alloc_table->real_ptr[i + 1];
-	    }
-	  _polybench_alloc_table->nb_entries--;
-	  _polybench_alloc_table->nb_avail_entries++;
-	  if (_polybench_alloc_table->nb_entries == 0)
-	    {
-	      free (_polybench_alloc_table->user_view);
-	      free (_polybench_alloc_table->real_ptr);
-	      free (_polybench_alloc_table);
-	      _polybench_alloc_table = NULL;
-	    }
+	  fprintf (stderr, "[PolyBench] perf_event_open failed; check "
+		   "/proc/sys/kernel/perf_event_paranoid\n");
+	  exit (1);
 	}
     }
 }
 
+
+/* Group leader of thread t, or -1. */
 static
-void check_alloc_table_state()
+int polybench_perf_leader(int t)
 {
-  if (_polybench_alloc_table == NULL)
-    {
-      _polybench_alloc_table = (struct polybench_data_ptrs*)
-	malloc (sizeof(struct polybench_data_ptrs));
-      assert(_polybench_alloc_table != NULL);
-      _polybench_alloc_table->user_view =
-	(void**) malloc (sizeof(void*) * NB_INITIAL_TABLE_ENTRIES);
-      assert(_polybench_alloc_table->user_view != NULL);
-      _polybench_alloc_table->real_ptr =
-	(void**) malloc (sizeof(void*) * NB_INITIAL_TABLE_ENTRIES);
-      assert(_polybench_alloc_table->real_ptr != NULL);
-      _polybench_alloc_table->nb_entries = 0;
-      _polybench_alloc_table->nb_avail_entries = NB_INITIAL_TABLE_ENTRIES;
-    }
+  int* fd = polybench_perf_fd + t * POLYBENCH_NB_PERF_EVENTS;
+  unsigned int i;
+  for (i = 0; i < POLYBENCH_NB_PERF_EVENTS; ++i)
+    if (fd[i] >= 0)
+      return fd[i];
+  return -1;
 }
 
-#endif // !POLYBENCH_ENABLE_INTARRAY_PAD
-
 
-static
-void*
-xmalloc(size_t alloc_sz)
+void polybench_perf_start()
 {
-  void* ret = NULL;
-  /* By default, post-pad the arrays. Safe behavior, but likely useless. */
+  int t;
+
+  if (polybench_perf_fd == NULL)
+    polybench_perf_init ();
+  polybench_prepare_instruments ();
+  for (t = 0; t < polybench_perf_nb_threads; ++t)
+    if (polybench_perf_leader (t) != -1)
+      ioctl (polybench_perf_leader (t), PERF_EVENT_IOC_RESET,
+	     PERF_IOC_FLAG_GROUP);
+  for (t = 0; t < polybench_perf_nb_threads; ++t)
+    if (polybench_perf_leader (t) != -1)
+      ioctl (polybench_perf_leader (t), PERF_EVENT_IOC_ENABLE,
+	     PERF_IOC_FLAG_GROUP);
+}
+
+
+void polybench_perf_stop()
+{
+  /* nr, time_enabled, time_running, then (value, id) per event. */
+  unsigned long long buf[3 + 2 * POLYBENCH_NB_PERF_EVENTS];
+  unsigned long long id;
+  unsigned int i, k;
+  int t;
+
+  for (t = 0; t < polybench_perf_nb_threads; ++t)
+    if (polybench_perf_leader (t) != -1)
+      ioctl (polybench_perf_leader (t), PERF_EVENT_IOC_DISABLE,
+	     PERF_IOC_FLAG_GROUP);
+  for (t = 0; t < polybench_perf_nb_threads; ++t)
+    {
+      int leader = polybench_perf_leader (t);
+      int* fd = polybench_perf_fd + t * POLYBENCH_NB_PERF_EVENTS;
+      unsigned long long* values =
+	polybench_perf_values + t * POLYBENCH_NB_PERF_EVENTS;
+      if (leader == -1)
+	continue;
+      if (read (leader, buf, sizeof(buf)) < 0)
+	{
+	  fprintf (stderr, "[PolyBench] cannot read perf counters\n");
+	  exit (1);
+	}
+      polybench_perf_time_enabled[t] = buf[1];
+      polybench_perf_time_running[t] = buf[2];
+      for (i = 0; i < POLYBENCH_NB_PERF_EVENTS; ++i)
+	{
+	  values[i] = 0;
+	  if (fd[i] < 0 || ioctl (fd[i], PERF_EVENT_IOC_ID, &id) == -1)
+	    continue;
+	  for (k = 0; k < buf[0]; ++k)
+	    if (buf[4 + 2 * k] == id)
+	      values[i] = buf[3 + 2 * k];
+	}
+    }
+#ifdef POLYBENCH_LINUX_FIFO_SCHEDULER
+  polybench_linux_standard_scheduler ();
+#endif
+}
+
+
+/* One line per thread (keys prefixed by t<id>.), then the sums over
+   all threads under the unprefixed keys. */
+void polybench_perf_print()
+{
+  unsigned long long sum[POLYBENCH_NB_PERF_EVENTS];
+  int multiplexed = 0;
+  unsigned int i;
+  int t;
+
+  memset (sum, 0, sizeof(sum));
+  for (t = 0; t < polybench_perf_nb_threads; ++t)
+    {
+      int* fd = polybench_perf_fd + t * POLYBENCH_NB_PERF_EVENTS;
+      unsigned long long* values =
+	polybench_perf_values + t * POLYBENCH_NB_PERF_EVENTS;
+      if (polybench_perf_leader (t) == -1)
+	continue;
+      printf ("[PolyBench] perf_thread:");
+      for (i = 0; i < POLYBENCH_NB_PERF_EVENTS; ++i)
+	if (fd[i] >= 0)
+	  {
+	    printf (" t%d.%s=%llu", t, polybench_perf_events[i].name, values[i]);
+	    sum[i] += values[i];
+	  }
+      printf (" t%d.time_running=%llu\n", t, polybench_perf_time_running[t]);
+      if (polybench_perf_time_running[t] < polybench_perf_time_enabled[t])
+	multiplexed = 1;
+    }
+
+  printf ("[PolyBench] perf:");
+  for (i = 0; i < POLYBENCH_NB_PERF_EVENTS; ++i)
+    if (polybench_perf_fd[i] >= 0)
+      printf (" %s=%llu", polybench_perf_events[i].name, sum[i]);
+  printf (" threads=%d time_enabled=%llu\n", polybench_perf_nb_threads,
+	  polybench_perf_time_enabled[0]);
+  if (multiplexed)
+    printf ("[PolyBench][WARNING] perf counters were multiplexed\n");
+
+  for (i = 0; i < polybench_perf_nb_threads * POLYBENCH_NB_PERF_EVENTS; ++i)
+    if (polybench_perf_fd[i] >= 0)
+      close (polybench_perf_fd[i]);
+  free (polybench_perf_fd);
+  free (polybench_perf_values);
+  free (polybench_perf_time_enabled);
+  free (polybench_perf_time_running);
+  polybench_perf_fd = NULL;
+}
+
+#endif
+/* ! POLYBENCH_PERF */
+
+#ifdef POLYBENCH_RUSAGE
+/*
+ * Resource usage of the timed region, with getrusage(RUSAGE_SELF), all
+ * threads included: page faults, context switches and CPU times are
+ * summed over the timed kernel executions (warm-up runs of the
+ * repetition engine excluded) and reported per execution. The growth
+ * of the resident set, read from /proc/self/statm around each execution,
+ * is the memory the kernel itself adds (first-touched outputs and
+ * temporaries); its largest value over the executions, warm-up
+ * included, is reported. ru_maxrss, the high-water mark of the whole
+ * process, is dominated by the harness buffers (cache flush, repetition
+ * snapshots), and reported apart as the process peak.
+ *
+ */
+static struct rusage polybench_rusage_begin_ru;
+static double polybench_rusage_last[6];
+static double polybench_rusage_sum[6];
+static int polybench_rusage_windows = 0;
+static long polybench_rusage_maxrss = 0;
+static long polybench_rusage_rss_begin = 0;
+static long polybench_rusage_rss_growth = 0;
+
+
+static
+double polybench_rusage_tv(struct timeval tv)
+{
+  return tv.tv_sec + tv.tv_usec * 1.0e-6;
+}
+
+
+/* Resident set size in kB, from /proc/self/statm (read without stdio,
+   which would allocate); -1 if unavailable. */
+static
+long polybench_rusage_rss()
+{
+  char buf[128];
+  long size, resident;
+  ssize_t n;
+  int fd = open ("/proc/self/statm", O_RDONLY);
+
+  if (fd < 0)
+    return -1;
+  n = read (fd, buf, sizeof(buf) - 1);
+  close (fd);
+  if (n <= 0)
+    return -1;
+  buf[n] = '\0';
+  if (sscanf (buf, "%ld %ld", &size, &resident) != 2)
+    return -1;
+  return resident * (sysconf (_SC_PAGESIZE) / 1024);
+}
+
+
+static
+void polybench_rusage_begin()
+{
+  polybench_rusage_rss_begin = polybench_rusage_rss ();
+  getrusage (RUSAGE_SELF, &polybench_rusage_begin_ru);
+}
+
+
+static
+void polybench_rusage_end()
+{
+  struct rusage ru, *b = &polybench_rusage_begin_ru;
+  long rss;
+  int i;
+
+  getrusage (RUSAGE_SELF, &ru);
+  rss = polybench_rusage_rss ();
+  if (rss >= 0 && polybench_rusage_rss_begin >= 0
+      && rss - polybench_rusage_rss_begin > polybench_rusage_rss_growth)
+    polybench_rusage_rss_growth = rss - polybench_rusage_rss_begin;
+  polybench_rusage_last[0] = ru.ru_minflt - b->ru_minflt;
+  polybench_rusage_last[1] = ru.ru_majflt - b->ru_majflt;
+  polybench_rusage_last[2] = ru.ru_nvcsw - b->ru_nvcsw;
+  polybench_rusage_last[3] = ru.ru_nivcsw - b->ru_nivcsw;
+  polybench_rusage_last[4] = polybench_rusage_tv (ru.ru_utime)
+    - polybench_rusage_tv (b->ru_utime);
+  polybench_rusage_last[5] = polybench_rusage_tv (ru.ru_stime)
+    - polybench_rusage_tv (b->ru_stime);
+  for (i = 0; i < 6; ++i)
+    polybench_rusage_sum[i] += polybench_rusage_last[i];
+  polybench_rusage_windows++;
+  polybench_rusage_maxrss = ru.ru_maxrss;
+}
+
+
+/* Forget the last timed region (a warm-up run). */
+static
+void polybench_rusage_discard()
+{
+  int i;
+  for (i = 0; i < 6; ++i)
+    polybench_rusage_sum[i] -= polybench_rusage_last[i];
+  polybench_rusage_windows--;
+}
+
+
+static
+void polybench_rusage_print_info()
+{
+  int n = polybench_rusage_windows > 0 ? polybench_rusage_windows : 1;
+  printf ("[PolyBench] rusage: rss_growth_kb=%ld process_maxrss_kb=%ld"
+	  " minflt=%0.1f majflt=%0.1f nvcsw=%0.1f nivcsw=%0.1f utime=%0.6f"
+	  " stime=%0.6f\n", polybench_rusage_rss_growth,
+	  polybench_rusage_maxrss, polybench_rusage_sum[0] / n,
+	  polybench_rusage_sum[1] / n, polybench_rusage_sum[2] / n,
+	  polybench_rusage_sum[3] / n, polybench_rusage_sum[4] / n,
+	  polybench_rusage_sum[5] / n);
+}
+#endif
+/* ! POLYBENCH_RUSAGE */
+
+void polybench_prepare_instruments()
+{
+  if (! polybench_cache_warm ())
+    polybench_flush_cache ();
+#ifdef POLYBENCH_LINUX_FIFO_SCHEDULER
+  polybench_linux_fifo_scheduler ();
+#endif
+}
+
+
+void polybench_timer_start()
+{
+#ifndef POLYBENCH_CYCLE_ACCURATE_TIMER
+# ifdef POLYBENCH_MONOTONIC_TIMER
+  if (polybench_timer_overhead < 0)
+    polybench_timer_calibrate ();
+# endif
+  polybench_prepare_instruments ();
+# ifdef POLYBENCH_TRACE
+  polybench_trace_event ("kernel", 'B');
+# endif
+# ifdef POLYBENCH_OMPT
+  polybench_ompt_control (POLYBENCH_OMPT_START);
+# endif
+# ifdef POLYBENCH_RUSAGE
+  polybench_rusage_begin ();
+# endif
+  polybench_t_start = rtclock ();
+#else
+  if (polybench_tsc_hz == 0)
+    polybench_tsc_calibrate ();
+  polybench_prepare_instruments ();
+# ifdef POLYBENCH_TRACE
+  polybench_trace_event ("kernel", 'B');
+# endif
+# ifdef POLYBENCH_OMPT
+  polybench_ompt_control (POLYBENCH_OMPT_START);
+# endif
+# ifdef POLYBENCH_RUSAGE
+  polybench_rusage_begin ();
+# endif
+  polybench_c_start = rdtsc ();
+#endif
+}
+
+
+void polybench_timer_stop()
+{
+#ifndef POLYBENCH_CYCLE_ACCURATE_TIMER
+  polybench_t_end = rtclock ();
+#else
+  polybench_c_end = rdtscp ();
+#endif
+#ifdef POLYBENCH_RUSAGE
+  polybench_rusage_end ();
+#endif
+#ifdef POLYBENCH_OMPT
+  polybench_ompt_control (POLYBENCH_OMPT_PAUSE);
+#endif
+#ifdef POLYBENCH_TRACE
+  polybench_trace_event ("kernel", 'E');
+#endif
+#ifdef POLYBENCH_LINUX_FIFO_SCHEDULER
+  polybench_linux_standard_scheduler ();
+#endif
+}
+
+
+/* Elapsed time of the last timed region, in seconds. */
+static
+double polybench_timer_elapsed()
+{
+#ifndef POLYBENCH_CYCLE_ACCURATE_TIMER
+  double t = polybench_t_end - polybench_t_start;
+  if (polybench_timer_overhead > 0)
+    t = t > polybench_timer_overhead ? t - polybench_timer_overhead : 0;
+  return t;
+#else
+  return polybench_timer_cycles () / polybench_tsc_hz;
+#endif
+}
+
+
+/* Report the OpenMP team and its binding, as applied by the runtime from
+   OMP_PROC_BIND and OMP_PLACES: the binding policy, the number of places,
+   and the CPU each thread of a parallel region runs on. */
+static
+void polybench_affinity_print_info()
+{
+#ifdef _OPENMP
+  static const char* bind_names[] =
+    { "false", "true", "master", "close", "spread" };
+  int nb = omp_get_max_threads ();
+  int bind = (int) omp_get_proc_bind ();
+  int* cpus = (int*) malloc (nb * sizeof(int));
+  int t;
+
+  if (cpus == NULL)
+    return;
+  for (t = 0; t < nb; t++)
+    cpus[t] = -1;
+#pragma omp parallel
+  {
+    unsigned cpu;
+#ifdef SYS_getcpu
+    if (syscall (SYS_getcpu, &cpu, NULL, NULL) == 0)
+      cpus[omp_get_thread_num ()] = (int) cpu;
+#else
+    (void) cpu;
+#endif
+  }
+  printf ("[PolyBench] affinity: omp_threads=%d proc_bind=%s places=%d cpus=",
+	  nb, bind >= 0 && bind <= 4 ? bind_names[bind] : "unknown",
+	  omp_get_num_places ());
+  for (t = 0; t < nb; t++)
+    printf ("%s%d", t ? "," : "", cpus[t]);
+  printf ("\n");
+  free (cpus);
+#endif
+}
+
+
+static void polybench_alloc_print_info();
+static void polybench_dataset_print_info();
+
+/* Report the timer in use, and its calibrated overhead. */
+static
+void polybench_timer_print_info()
+{
+#if defined(POLYBENCH_CYCLE_ACCURATE_TIMER)
+  printf ("[PolyBench] timer: clock=tsc tsc_hz=%0.0f invariant_tsc=%d rdtscp=%d timer_overhead_cycles=%llu\n",
+	  polybench_tsc_hz, polybench_tsc_invariant, polybench_tsc_rdtscp,
+	  polybench_tsc_overhead);
+#elif defined(POLYBENCH_MONOTONIC_TIMER)
+  printf ("[PolyBench] timer: clock=%s timer_overhead=%0.9f\n",
+	  POLYBENCH_CLOCK_NAME, polybench_timer_overhead);
+#endif
+  if (polybench_program_total_flops > 0 || polybench_program_total_bytes > 0)
+    printf ("[PolyBench] model: flops=%0.0f bytes=%0.0f intensity=%0.6f\n",
+	    polybench_program_total_flops, polybench_program_total_bytes,
+	    polybench_program_total_bytes > 0 ?
+	    polybench_program_total_flops / polybench_program_total_bytes : 0);
+  polybench_affinity_print_info ();
+  polybench_flush_print_info ();
+  polybench_alloc_print_info ();
+#ifdef POLYBENCH_RUSAGE
+  polybench_rusage_print_info ();
+#endif
+#ifdef POLYBENCH_DYNAMIC_SIZES
+  polybench_sizes_print_info ();
+#endif
+  polybench_dataset_print_info ();
+}
+
+
+void polybench_timer_print()
+{
+#ifdef POLYBENCH_GFLOPS
+      if  (polybench_program_total_flops == 0)
+	{
+	  printf ("[PolyBench][WARNING] Program flops not defined, use polybench_set_program_flops(value)\n");
+	  printf (POLYBENCH_TIME_FMT "\n", polybench_timer_elapsed ());
+	}
+      else
+	printf ("%0.2lf\n",
+		(polybench_program_total_flops /
+		 polybench_timer_elapsed ()) / 1000000000);
+#else
+      printf (POLYBENCH_TIME_FMT "\n", polybench_timer_elapsed ());
+# ifdef POLYBENCH_CYCLE_ACCURATE_TIMER
+      printf ("[PolyBench] cycles: cycles=%llu\n", polybench_timer_cycles ());
+# endif
+#endif
+      polybench_timer_print_info ();
+}
+
+static
+size_t polybench_data_hash(void* ptr)
+{
+  unsigned long long h = (unsigned long long) (size_t) ptr;
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  return (size_t) h & (polybench_data_index_sz - 1);
+}
+
+
+/* Slot of ptr in the index, or of the empty slot where it belongs. */
+static
+size_t polybench_data_slot(void* ptr)
+{
+  size_t s = polybench_data_hash (ptr);
+  while (polybench_data_index[s] != 0
+	 && _polybench_data_registry[polybench_data_index[s] - 1].ptr != ptr)
+    s = (s + 1) & (polybench_data_index_sz - 1);
+  return s;
+}
+
+
+/* Rebuild the index with at least twice as many slots as entries. */
+static
+void polybench_data_index_grow()
+{
+  int i;
+  polybench_data_index_sz = polybench_data_index_sz ?
+    2 * polybench_data_index_sz : 2 * NB_INITIAL_TABLE_ENTRIES;
+  free (polybench_data_index);
+  polybench_data_index = (int*) calloc (polybench_data_index_sz, sizeof(int));
+  assert(polybench_data_index != NULL);
+  for (i = 0; i < polybench_data_registry_nb; ++i)
+    polybench_data_index[polybench_data_slot
+			 (_polybench_data_registry[i].ptr)] = i + 1;
+}
+
+
+/* Empty slot s, moving back the entries of its probe sequence that
+   could no longer be reached. */
+static
+void polybench_data_index_erase(size_t s)
+{
+  size_t mask = polybench_data_index_sz - 1;
+  size_t j = s;
+  polybench_data_index[s] = 0;
+  for (j = (j + 1) & mask; polybench_data_index[j] != 0; j = (j + 1) & mask)
+    {
+      size_t h = polybench_data_hash
+	(_polybench_data_registry[polybench_data_index[j] - 1].ptr);
+      /* Move j to s unless its home slot h lies cyclically in (s, j]. */
+      if (s <= j ? (s < h && h <= j) : (s < h || h <= j))
+	continue;
+      polybench_data_index[s] = polybench_data_index[j];
+      polybench_data_index[j] = 0;
+      s = j;
+    }
+}
+
+
+static
+void register_data(void* ptr, size_t sz, void* base, size_t map_sz,
+		   int pages)
+{
+  if (polybench_data_registry_avail == 0)
+    {
+      size_t nb = polybench_data_registry_nb + NB_INITIAL_TABLE_ENTRIES;
+      _polybench_data_registry = (struct polybench_data_entry*)
+	realloc (_polybench_data_registry,
+		 nb * sizeof(struct polybench_data_entry));
+      assert(_polybench_data_registry != NULL);
+      polybench_data_registry_avail = NB_INITIAL_TABLE_ENTRIES;
+    }
+  struct polybench_data_entry* e =
+    &_polybench_data_registry[polybench_data_registry_nb++];
+  e->ptr = ptr;
+  e->sz = sz;
+  e->snapshot = NULL;
+  e->base = base;
+  e->map_sz = map_sz;
+  e->pages = pages;
+  e->nb_dims = 0;
+  polybench_data_registry_avail--;
+  if (2 * (size_t) polybench_data_registry_nb > polybench_data_index_sz)
+    polybench_data_index_grow ();
+  else
+    polybench_data_index[polybench_data_slot (ptr)] =
+      polybench_data_registry_nb;
+}
+
+
+/* Forget ptr, returning its entry in e; 0 if ptr is not registered.
+   The last entry of the registry takes the place of the removed one. */
+static
+int unregister_data(void* ptr, struct polybench_data_entry* e)
+{
+  size_t s;
+  int i, last;
+  if (polybench_data_index == NULL)
+    return 0;
+  s = polybench_data_slot (ptr);
+  if (polybench_data_index[s] == 0)
+    return 0;
+  i = polybench_data_index[s] - 1;
+  polybench_data_index_erase (s);
+  *e = _polybench_data_registry[i];
+  free (_polybench_data_registry[i].snapshot);
+  last = --polybench_data_registry_nb;
+  if (i != last)
+    {
+      _polybench_data_registry[i] = _polybench_data_registry[last];
+      polybench_data_index[polybench_data_slot
+			   (_polybench_data_registry[i].ptr)] = i + 1;
+    }
+  polybench_data_registry_avail++;
+  if (polybench_data_registry_nb == 0)
+    {
+      free (_polybench_data_registry);
+      _polybench_data_registry = NULL;
+      polybench_data_registry_avail = 0;
+      free (polybench_data_index);
+      polybench_data_index = NULL;
+      polybench_data_index_sz = 0;
+    }
+  return 1;
+}
+
+
+#ifdef POLYBENCH_REPEAT
+/*
+ * Repetition engine. The kernel is executed POLYBENCH_WARMUP +
+ * POLYBENCH_REPS times in the same process. The arrays are
+ * snapshotted once after initialization, and restored with a bulk
+ * copy before each execution, so that every repetition computes on
+ * the same input data. This doubles the memory footprint.
+ *
+ * When POLYBENCH_CI_TARGET (in %) is set, POLYBENCH_REPS is only the
+ * minimum: sampling goes on until the half-width of the 95%
+ * confidence interval of the median falls below the target, the
+ * POLYBENCH_TIME_BUDGET (in seconds) is exhausted, or
+ * POLYBENCH_MAX_REPS samples are collected.
+ *
+ */
+static int polybench_repeat_reps = 0;
+static int polybench_repeat_warmup = 0;
+static int polybench_repeat_max = 0;
+static int polybench_repeat_iter = 0;
+static int polybench_repeat_cap = 0;
+static int polybench_repeat_next_check = 0;
+static double polybench_repeat_ci_target = 0;
+static double polybench_repeat_budget = 0;
+static double polybench_repeat_t_begin = 0;
+static double* polybench_repeat_times = NULL;
+
+static
+double polybench_env_double(const char* name, double def)
+{
+  char* val = getenv (name);
+  if (val == NULL || *val == '\0')
+    return def;
+  double ret = atof (val);
+  return ret >= 0 ? ret : def;
+}
+
+static
+int compare_doubles(const void* a, const void* b)
+{
+  double x = *(const double*) a, y = *(const double*) b;
+  return (x > y) - (x < y);
+}
+
+static
+double median_of_sorted(double* vals, int n)
+{
+  return n % 2 ? vals[n / 2] : (vals[n / 2 - 1] + vals[n / 2]) / 2;
+}
+
+/* Distribution-free 95% confidence interval of the median: the
+   order statistics of ranks (n -+ 1.96 sqrt(n)) / 2 of sorted samples.
+   The width is rounded up, which slightly widens the interval. */
+static
+void median_ci_of_sorted(double* vals, int n, double* lo, double* hi)
+{
+  long w = (long) ceil (1.96 * sqrt ((double) n));
+  long j = (n - w) / 2;
+  long k = (n + w + 1) / 2;
+  if (j < 0)
+    j = 0;
+  if (k > n - 1)
+    k = n - 1;
+  *lo = vals[j];
+  *hi = vals[k];
+}
+
+/* Copy of an array between repetitions, split in page-sized chunks over
+   the threads with a static schedule, as the initializers and the
+   kernels' omp for loops split the rows: the copy may be the first
+   touch of an output the initializer does not write, and a serial one
+   would place all its pages on the master's NUMA node. */
+static
+void polybench_repeat_copy(void* dst, const void* src, size_t sz)
+{
+  size_t page = 4096, nb = (sz + page - 1) / page, k;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (k = 0; k < nb; ++k)
+    memcpy ((char*) dst + k * page, (const char*) src + k * page,
+	    k == nb - 1 ? sz - k * page : page);
+}
+
+
+/* Relative half-width (in %) of the confidence interval of the median. */
+static
+double polybench_repeat_ci(int n)
+{
+  double lo, hi, median;
+  double* sorted = (double*) malloc (n * sizeof(double));
+  assert(sorted != NULL);
+  memcpy (sorted, polybench_repeat_times, n * sizeof(double));
+  qsort (sorted, n, sizeof(double), compare_doubles);
+  median = median_of_sorted (sorted, n);
+  median_ci_of_sorted (sorted, n, &lo, &hi);
+  free (sorted);
+  return median > 0 ? (hi - lo) / 2 / median * 100 : 0;
+}
+
+
+void polybench_repeat_init()
+{
+  int i;
+  polybench_repeat_reps =
+    polybench_env_int ("POLYBENCH_REPS", POLYBENCH_REPEAT_COUNT);
+  if (polybench_repeat_reps < 1)
+    polybench_repeat_reps = 1;
+  polybench_repeat_warmup =
+    polybench_env_int ("POLYBENCH_WARMUP", POLYBENCH_REPEAT_WARMUP);
+  polybench_repeat_max =
+    polybench_env_int ("POLYBENCH_MAX_REPS", POLYBENCH_REPEAT_MAX);
+  if (polybench_repeat_max < polybench_repeat_reps)
+    polybench_repeat_max = polybench_repeat_reps;
+  polybench_repeat_ci_target =
+    polybench_env_double ("POLYBENCH_CI_TARGET", 0);
+  polybench_repeat_budget =
+    polybench_env_double ("POLYBENCH_TIME_BUDGET", 0);
+  polybench_repeat_iter = 0;
+  polybench_repeat_next_check = polybench_repeat_reps;
+  polybench_repeat_cap = polybench_repeat_reps;
+  polybench_repeat_times =
+    (double*) malloc (polybench_repeat_cap * sizeof(double));
+  assert(polybench_repeat_times != NULL);
+
+  for (i = 0; i < polybench_data_registry_nb; ++i)
+    {
+      struct polybench_data_entry* e = &_polybench_data_registry[i];
+      e->snapshot = malloc (e->sz);
+      if (e->snapshot == NULL)
+	{
+	  fprintf (stderr, "[PolyBench] repeat: cannot allocate snapshot memory\n");
+	  exit (1);
+	}
+      polybench_repeat_copy (e->snapshot, e->ptr, e->sz);
+    }
+  polybench_repeat_t_begin = rtclock ();
+}
+
+
+static
+int polybench_repeat_done()
+{
+  int n = polybench_repeat_iter - polybench_repeat_warmup;
+  if (n < polybench_repeat_reps)
+    return 0;
+  if (polybench_repeat_ci_target <= 0 || n >= polybench_repeat_max)
+    return 1;
+  if (polybench_repeat_budget > 0 &&
+      rtclock () - polybench_repeat_t_begin >= polybench_repeat_budget)
+    return 1;
+  /* Re-evaluate the interval each time the sample grows by ~10%. */
+  if (n < polybench_repeat_next_check)
+    return 0;
+  polybench_repeat_next_check = n + (n / 10 > 1 ? n / 10 : 1);
+  return polybench_repeat_ci (n) <= polybench_repeat_ci_target;
+}
+
+
+int polybench_repeat_next()
+{
+  int i;
+  if (polybench_repeat_done ())
+    {
+      for (i = 0; i < polybench_data_registry_nb; ++i)
+	{
+	  free (_polybench_data_registry[i].snapshot);
+	  _polybench_data_registry[i].snapshot = NULL;
+	}
+      return 0;
+    }
+  for (i = 0; i < polybench_data_registry_nb; ++i)
+    polybench_repeat_copy (_polybench_data_registry[i].ptr,
+			   _polybench_data_registry[i].snapshot,
+			   _polybench_data_registry[i].sz);
+  return 1;
+}
+
+
+void polybench_repeat_record()
+{
+  int n = polybench_repeat_iter - polybench_repeat_warmup;
+  polybench_repeat_iter++;
+  if (n < 0)
+    {
+#ifdef POLYBENCH_RUSAGE
+      polybench_rusage_discard ();
+#endif
+      return;
+    }
+  if (n == polybench_repeat_cap)
+    {
+      polybench_repeat_cap *= 2;
+      polybench_repeat_times = (double*)
+	realloc (polybench_repeat_times, polybench_repeat_cap * sizeof(double));
+      assert(polybench_repeat_times != NULL);
+    }
+  polybench_repeat_times[n] = polybench_timer_elapsed ();
+}
+
+
+void polybench_repeat_print()
+{
+  int i, n = polybench_repeat_iter - polybench_repeat_warmup;
+  double lo, hi;
+  double* dev = (double*) malloc (n * sizeof(double));
+  assert(dev != NULL);
+
+  qsort (polybench_repeat_times, n, sizeof(double), compare_doubles);
+  double median = median_of_sorted (polybench_repeat_times, n);
+  for (i = 0; i < n; ++i)
+    dev[i] = fabs (polybench_repeat_times[i] - median);
+  qsort (dev, n, sizeof(double), compare_doubles);
+  double mad = median_of_sorted (dev, n);
+  median_ci_of_sorted (polybench_repeat_times, n, &lo, &hi);
+  double ci = median > 0 ? (hi - lo) / 2 / median * 100 : 0;
+
+#define F POLYBENCH_TIME_FMT
+  printf (F "\n", median);
+  printf ("[PolyBench] repeat: reps=%d warmup=%d median=" F " mad=" F " min=" F " ci_lo=" F " ci_hi=" F " ci=%0.3f\n",
+	  n, polybench_repeat_warmup, median, mad, polybench_repeat_times[0],
+	  lo, hi, ci);
+#undef F
+#ifdef POLYBENCH_CYCLE_ACCURATE_TIMER
+  printf ("[PolyBench] cycles: cycles=%0.0f\n", median * polybench_tsc_hz);
+#endif
+  polybench_timer_print_info ();
+
+  free (dev);
+  free (polybench_repeat_times);
+  polybench_repeat_times = NULL;
+}
+#endif
+/* ! POLYBENCH_REPEAT */
+
+#ifdef POLYBENCH_TRACE
+/* Region tracing: each thread appends begin/end events to its own
+   ring, written only by that thread, so recording takes no lock.
+   When a ring is full the oldest events are overwritten. Rings are
+   dumped at exit in the Chrome trace event format, readable by
+   chrome://tracing and Perfetto.
+
+   A ring belongs to an OS thread, not to an OpenMP thread number:
+   with nested parallel regions several threads share a number. Each
+   thread takes the next ring id from a counter on its first event;
+   threads beyond the preallocated rings are not traced. */
+struct polybench_trace_event_record
+{
+  const char* name;
+  double ts;
+  char phase;
+};
+
+struct polybench_trace_ring
+{
+  struct polybench_trace_event_record* events;
+  unsigned long long count;
+  /* Keep the rings of different threads on separate cache lines. */
+  char pad[64 - sizeof(void*) - sizeof(unsigned long long)];
+};
+
+static struct polybench_trace_ring* polybench_trace_rings = NULL;
+static int polybench_trace_nb_rings = 0;
+static int polybench_trace_size = 0;
+static double polybench_trace_origin = 0;
+static int polybench_trace_next_id = 0;
+static __thread int polybench_trace_id = -1;
+
+
+static
+double polybench_trace_clock()
+{
+  struct timespec Tp;
+  clock_gettime (POLYBENCH_CLOCK_ID, &Tp);
+  return (Tp.tv_sec + Tp.tv_nsec * 1.0e-9);
+}
+
+
+void polybench_trace_event(const char* name, char phase)
+{
+  int t = polybench_trace_id;
+  if (t < 0)
+    t = polybench_trace_id =
+      __atomic_fetch_add (&polybench_trace_next_id, 1, __ATOMIC_RELAXED);
+  if (t >= polybench_trace_nb_rings)
+    return;
+  struct polybench_trace_ring* r = &polybench_trace_rings[t];
+  struct polybench_trace_event_record* e =
+    &r->events[r->count++ % polybench_trace_size];
+  e->ts = polybench_trace_clock ();
+  e->name = name;
+  e->phase = phase;
+}
+
+
+static
+void polybench_trace_dump()
+{
+  const char* path = getenv ("POLYBENCH_TRACE_FILE");
+  FILE* f;
+  int t, first = 1;
+  unsigned long long k, dropped = 0;
+
+  if (path == NULL || *path == '\0')
+    path = "polybench_trace.json";
+  f = fopen (path, "w");
+  if (f == NULL)
+    {
+      fprintf (stderr, "[PolyBench] cannot write trace file %s\n", path);
+      return;
+    }
+  fprintf (f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+  for (t = 0; t < polybench_trace_nb_rings; ++t)
+    {
+      struct polybench_trace_ring* r = &polybench_trace_rings[t];
+      unsigned long long start = 0;
+      if (r->count == 0)
+	continue;
+      if (r->count > (unsigned long long) polybench_trace_size)
+	{
+	  start = r->count - polybench_trace_size;
+	  dropped += start;
+	}
+      fprintf (f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,"
+	       "\"tid\":%d,\"args\":{\"name\":\"thread %d\"}}",
+	       first ? "" : ",\n", (int) getpid (), t, t);
+      first = 0;
+      for (k = start; k < r->count; ++k)
+	{
+	  struct polybench_trace_event_record* e =
+	    &r->events[k % polybench_trace_size];
+	  fprintf (f, ",\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%0.3f,"
+		   "\"pid\":%d,\"tid\":%d}", e->name, e->phase,
+		   (e->ts - polybench_trace_origin) * 1.0e6,
+		   (int) getpid (), t);
+	}
+      free (r->events);
+    }
+  fprintf (f, "\n]}\n");
+  fclose (f);
+  free (polybench_trace_rings);
+  polybench_trace_rings = NULL;
+  if (dropped)
+    fprintf (stderr, "[PolyBench][WARNING] trace rings overflowed, %llu "
+	     "oldest events dropped (see POLYBENCH_TRACE_EVENTS)\n", dropped);
+  if (polybench_trace_next_id > polybench_trace_nb_rings)
+    fprintf (stderr, "[PolyBench][WARNING] %d threads had no trace ring, "
+	     "their events were dropped\n",
+	     polybench_trace_next_id - polybench_trace_nb_rings);
+  polybench_trace_nb_rings = 0;
+}
+
+
+/* aligned_alloc wants a size multiple of the alignment. */
+static
+void* polybench_trace_alloc(size_t size)
+{
+  void* p = aligned_alloc (64, (size + 63) & ~(size_t) 63);
+  if (p == NULL)
+    {
+      fprintf (stderr, "[PolyBench] Not enough memory for trace rings\n");
+      exit (1);
+    }
+  memset (p, 0, size);
+  return p;
+}
+
+
+/* Rings are allocated before main, out of any timed region. */
+__attribute__((constructor))
+static
+void polybench_trace_init()
+{
+  int t, nb = 1;
+#ifdef _OPENMP
+  nb = omp_get_max_threads ();
+#endif
+  polybench_trace_size = polybench_env_int ("POLYBENCH_TRACE_EVENTS",
+					    POLYBENCH_TRACE_EVENTS);
+  if (polybench_trace_size < 1)
+    polybench_trace_size = 1;
+  polybench_trace_rings = (struct polybench_trace_ring*)
+    polybench_trace_alloc (nb * sizeof(struct polybench_trace_ring));
+  for (t = 0; t < nb; ++t)
+    polybench_trace_rings[t].events = (struct polybench_trace_event_record*)
+      polybench_trace_alloc (polybench_trace_size *
+			     sizeof(struct polybench_trace_event_record));
+  polybench_trace_nb_rings = nb;
+  polybench_trace_origin = polybench_trace_clock ();
+  atexit (polybench_trace_dump);
+}
+#endif
+/* ! POLYBENCH_TRACE */
+
+
+
+
+/*
+ * Page policy of the arrays: 4k (default pages), thp (transparent huge
+ * pages, requested with madvise), 2m or 1g (explicit hugetlbfs pages,
+ * which must be reserved, e.g. in /proc/sys/vm/nr_hugepages). Set at
+ * build time with -DPOLYBENCH_ALLOC_POLICY=thp, or at run time with
+ * POLYBENCH_ALLOC=thp. When a policy cannot be honored, the allocation
+ * falls back to the next smaller pages: 1g, 2m, thp, then 4k.
+ *
+ */
+#define POLYBENCH_PAGES_4K 0
+#define POLYBENCH_PAGES_THP 1
+#define POLYBENCH_PAGES_2M 2
+#define POLYBENCH_PAGES_1G 3
+static const char* polybench_pages_names[] = { "4k", "thp", "2m", "1g" };
+static int polybench_alloc_policy = -1;
+/* Smallest pages actually obtained, over all allocations. */
+static int polybench_alloc_effective = -1;
+
+#ifndef MAP_HUGE_SHIFT
+# define MAP_HUGE_SHIFT 26
+#endif
+#define POLYBENCH_HUGE_2M (2UL << 20)
+#define POLYBENCH_HUGE_1G (1UL << 30)
+
+static
+int polybench_get_alloc_policy()
+{
+  if (polybench_alloc_policy == -1)
+    {
+      const char* val = getenv ("POLYBENCH_ALLOC");
+      int k;
+      if (val == NULL || *val == '\0')
+	val = POLYBENCH_XSTR(POLYBENCH_ALLOC_POLICY);
+      polybench_alloc_policy = POLYBENCH_PAGES_4K;
+      for (k = 0; k <= POLYBENCH_PAGES_1G; ++k)
+	if (strcmp (val, polybench_pages_names[k]) == 0)
+	  polybench_alloc_policy = k;
+      if (strcmp (val, polybench_pages_names[polybench_alloc_policy]) != 0)
+	printf ("[PolyBench][WARNING] unknown allocation policy %s, using 4k\n",
+		val);
+    }
+  return polybench_alloc_policy;
+}
+
+
+/* Allocate sz bytes with the requested kind of pages, or smaller ones;
+   the kind obtained and the size actually mapped are returned. */
+static
+void* polybench_alloc_pages(size_t sz, int* pages, size_t* map_sz)
+{
+  void* ret = NULL;
+#ifdef MAP_HUGETLB
+  int kind;
+
+  /* hugetlbfs and transparent huge pages are Linux only: elsewhere,
+     4k pages are used, with the usual warning. */
+  for (kind = *pages; kind >= POLYBENCH_PAGES_2M; --kind)
+    {
+      size_t huge = kind == POLYBENCH_PAGES_1G ?
+	POLYBENCH_HUGE_1G : POLYBENCH_HUGE_2M;
+      int flag = (kind == POLYBENCH_PAGES_1G ? 30 : 21) << MAP_HUGE_SHIFT;
+      *map_sz = (sz + huge - 1) / huge * huge;
+      ret = mmap (NULL, *map_sz, PROT_READ | PROT_WRITE,
+		  MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | flag, -1, 0);
+      if (ret != MAP_FAILED)
+	{
+	  *pages = kind;
+	  return ret;
+	}
+    }
+#endif
+#ifdef MADV_HUGEPAGE
+  if (*pages >= POLYBENCH_PAGES_THP)
+    {
+      *map_sz = (sz + POLYBENCH_HUGE_2M - 1) / POLYBENCH_HUGE_2M
+	* POLYBENCH_HUGE_2M;
+      if (posix_memalign (&ret, POLYBENCH_HUGE_2M, *map_sz) == 0 && ret)
+	{
+	  if (madvise (ret, *map_sz, MADV_HUGEPAGE) == 0)
+	    {
+	      *pages = POLYBENCH_PAGES_THP;
+	      return ret;
+	    }
+	  free (ret);
+	}
+    }
+#endif
+  /* Whole pages, mapped for the array alone: mbind on the array moves
+     no other data, and the dataset cache may map a file over them. */
+  *map_sz = sz > 0 ? (sz + 4095) & ~(size_t) 4095 : 4096;
+  ret = mmap (NULL, *map_sz, PROT_READ | PROT_WRITE,
+	      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (ret == MAP_FAILED)
+    {
+      fprintf (stderr, "[PolyBench] mmap: cannot allocate memory\n");
+      exit (1);
+    }
+  *pages = POLYBENCH_PAGES_4K;
+
+  return ret;
+}
+
+
+static
+void polybench_free_pages(void* base, size_t map_sz, int pages)
+{
+  if (pages == POLYBENCH_PAGES_THP)
+    free (base);
+  else
+    munmap (base, map_sz);
+}
+
+
+/*
+ * NUMA placement of the arrays, with the mbind / set_mempolicy system
+ * calls (no libnuma): none (default: first touch, by whichever thread
+ * initializes the data), interleave (pages spread round-robin over all
+ * online nodes), bind:N (all pages on node N), or local (pages on the
+ * node of the thread that first touches them: the initializers of
+ * headers/<program>_init.h write the arrays in schedule(static) loops
+ * over the dimension the kernels' omp for loops split, so that each
+ * thread's share is local to it). Set at run time with POLYBENCH_NUMA;
+ * other systems than Linux report numa=unsupported, and do nothing.
+ *
+ */
+#define POLYBENCH_NUMA_NONE 0
+#define POLYBENCH_NUMA_INTERLEAVE 1
+#define POLYBENCH_NUMA_BIND 2
+#define POLYBENCH_NUMA_LOCAL 3
+#define POLYBENCH_NUMA_UNSUPPORTED 4
+static const char* polybench_numa_names[] =
+  { "none", "interleave", "bind", "local", "unsupported" };
+static int polybench_numa_policy = -1;
+static int polybench_numa_node = 0;
+static int polybench_numa_nb_nodes = 0;
+static unsigned long polybench_numa_online[16];
+
+/* Parse /sys/devices/system/node/online, e.g. "0-1,3". */
+static
+void polybench_numa_read_nodes()
+{
+  char buf[256], *p = buf;
+  FILE* f = fopen ("/sys/devices/system/node/online", "r");
+  memset (polybench_numa_online, 0, sizeof(polybench_numa_online));
+  polybench_numa_nb_nodes = 0;
+  if (f == NULL || fgets (buf, sizeof(buf), f) == NULL)
+    {
+      if (f)
+	fclose (f);
+      polybench_numa_online[0] = 1;
+      polybench_numa_nb_nodes = 1;
+      return;
+    }
+  fclose (f);
+  while (*p >= '0' && *p <= '9')
+    {
+      int lo = strtol (p, &p, 10), hi = lo, n;
+      if (*p == '-')
+	hi = strtol (p + 1, &p, 10);
+      for (n = lo; n <= hi && n < 16 * 64; n++)
+	{
+	  polybench_numa_online[n / 64] |= 1UL << (n % 64);
+	  polybench_numa_nb_nodes++;
+	}
+      if (*p == ',')
+	p++;
+    }
+}
+
+
+static
+int polybench_get_numa_policy()
+{
+  if (polybench_numa_policy == -1)
+    {
+      const char* val = getenv ("POLYBENCH_NUMA");
+      polybench_numa_policy = POLYBENCH_NUMA_NONE;
+      polybench_numa_read_nodes ();
+#ifndef __linux__
+      /* mbind and set_mempolicy are Linux system calls. */
+      polybench_numa_policy = POLYBENCH_NUMA_UNSUPPORTED;
+      return polybench_numa_policy;
+#endif
+      if (val == NULL || *val == '\0' || strcmp (val, "none") == 0)
+	return polybench_numa_policy;
+      if (strcmp (val, "interleave") == 0)
+	polybench_numa_policy = POLYBENCH_NUMA_INTERLEAVE;
+      else if (strcmp (val, "local") == 0)
+	polybench_numa_policy = POLYBENCH_NUMA_LOCAL;
+      else if (strncmp (val, "bind:", 5) == 0)
+	{
+	  polybench_numa_node = atoi (val + 5);
+	  if (polybench_numa_node >= 0 && polybench_numa_node < 16 * 64
+	      && (polybench_numa_online[polybench_numa_node / 64]
+		  >> (polybench_numa_node % 64) & 1))
+	    polybench_numa_policy = POLYBENCH_NUMA_BIND;
+	  else
+	    printf ("[PolyBench][WARNING] NUMA node %d is not online\n",
+		    polybench_numa_node);
+	}
+      else
+	printf ("[PolyBench][WARNING] unknown NUMA policy %s, using none\n",
+		val);
+#ifdef __linux__
+      /* Explicit local allocation, whatever the inherited policy. */
+      if (polybench_numa_policy == POLYBENCH_NUMA_LOCAL
+	  && syscall (SYS_set_mempolicy, MPOL_LOCAL, NULL, 0) != 0)
+	printf ("[PolyBench][WARNING] set_mempolicy failed\n");
+#endif
+    }
+  return polybench_numa_policy;
+}
+
+
+/* Apply the NUMA policy to a new allocation of map_sz bytes, page
+   aligned and made of whole pages: mbind applies to whole pages. */
+static
+void polybench_numa_place(void* base, size_t map_sz)
+{
+#ifdef __linux__
+  unsigned long mask[16];
+  int mode;
+
+  switch (polybench_get_numa_policy ())
+    {
+    case POLYBENCH_NUMA_INTERLEAVE:
+      memcpy (mask, polybench_numa_online, sizeof(mask));
+      mode = MPOL_INTERLEAVE;
+      break;
+    case POLYBENCH_NUMA_BIND:
+      memset (mask, 0, sizeof(mask));
+      mask[polybench_numa_node / 64] = 1UL << (polybench_numa_node % 64);
+      mode = MPOL_BIND;
+      break;
+    default:
+      /* local: set_mempolicy, and first touch by the initializers. */
+      return;
+    }
+  if (syscall (SYS_mbind, base, map_sz, mode, mask, sizeof(mask) * 8 + 1,
+	       MPOL_MF_MOVE) != 0)
+    printf ("[PolyBench][WARNING] mbind failed, NUMA policy not applied\n");
+#else
+  (void) base;
+  (void) map_sz;
+#endif
+}
+
+
+/*
+ * Arena allocation: all the arrays are carved, in allocation order,
+ * from a single reservation of address space, mapped without swap
+ * reservation so that only the pages actually touched are committed.
+ * Array k starts on an align-byte boundary, plus k * offset bytes
+ * (plus the inter-array padding, if any), so that the relative
+ * alignment of the arrays, and hence their conflicts in the cache
+ * sets, can be controlled. Freeing an array is a no-op; the whole
+ * arena is released when the last array is freed. Huge pages are
+ * transparent ones (a hugetlbfs arena would have to be sized upfront).
+ *
+ */
+static int polybench_arena_enabled = -1;
+static char* polybench_arena_base = NULL;
+static size_t polybench_arena_sz = 0;
+static size_t polybench_arena_used = 0;
+static size_t polybench_arena_peak = 0;
+static size_t polybench_arena_align = 0;
+static size_t polybench_arena_offset = 0;
+static int polybench_arena_nb = 0;
+
+static
+int polybench_use_arena()
+{
+  if (polybench_arena_enabled == -1)
+    {
+#ifdef POLYBENCH_ARENA
+      polybench_arena_enabled = polybench_env_int ("POLYBENCH_ARENA", 1) != 0;
+#else
+      polybench_arena_enabled = polybench_env_int ("POLYBENCH_ARENA", 0) != 0;
+#endif
+      polybench_arena_align =
+	polybench_env_int ("POLYBENCH_ARENA_ALIGN", POLYBENCH_ARENA_ALIGN);
+      polybench_arena_offset =
+	polybench_env_int ("POLYBENCH_ARENA_OFFSET", POLYBENCH_ARENA_OFFSET);
+      if (polybench_arena_align == 0
+	  || (polybench_arena_align & (polybench_arena_align - 1)) != 0)
+	{
+	  printf ("[PolyBench][WARNING] arena alignment %zu is not a power"
+		  " of 2, using %d\n", polybench_arena_align,
+		  POLYBENCH_ARENA_ALIGN);
+	  polybench_arena_align = POLYBENCH_ARENA_ALIGN;
+	}
+    }
+  return polybench_arena_enabled;
+}
+
+
+/* Reserve the arena, halving the request while the kernel refuses it
+   (e.g. with strict overcommit); 0 if even 1 GB cannot be reserved. */
+static
+int polybench_arena_reserve(int* pages)
+{
+  size_t sz = (size_t) POLYBENCH_ARENA_RESERVE_MB << 20;
+  for (; sz >= POLYBENCH_HUGE_1G; sz /= 2)
+    {
+      void* p = mmap (NULL, sz, PROT_READ | PROT_WRITE,
+		      MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+      if (p == MAP_FAILED)
+	continue;
+      /* The policy is applied once, to the whole arena: arrays share
+	 pages with their neighbours. */
+      polybench_numa_place (p, sz);
+      polybench_arena_base = (char*) p;
+      polybench_arena_sz = sz;
+      polybench_arena_used = 0;
+      polybench_arena_nb = 0;
+#ifdef MADV_HUGEPAGE
+      if (*pages >= POLYBENCH_PAGES_THP
+	  && madvise (p, sz, MADV_HUGEPAGE) == 0)
+	*pages = POLYBENCH_PAGES_THP;
+      else
+#endif
+	*pages = POLYBENCH_PAGES_4K;
+      return 1;
+    }
+  return 0;
+}
+
+
+/* Carve sz bytes from the arena; NULL if it cannot hold them. */
+static
+void* polybench_arena_alloc(size_t sz, int* pages)
+{
+  static int arena_pages;
+  size_t start;
+
+  if (polybench_arena_base == NULL)
+    {
+      arena_pages = *pages;
+      if (! polybench_arena_reserve (&arena_pages))
+	{
+	  printf ("[PolyBench][WARNING] cannot reserve the arena,"
+		  " using separate allocations\n");
+	  polybench_arena_enabled = 0;
+	  return NULL;
+	}
+    }
+  start = (polybench_arena_used + polybench_arena_align - 1)
+    & ~(polybench_arena_align - 1);
+  start += polybench_arena_nb * polybench_arena_offset;
+  if (start + sz > polybench_arena_sz || start + sz < start)
+    return NULL;
+  polybench_arena_used = start + sz;
+  if (polybench_arena_used > polybench_arena_peak)
+    polybench_arena_peak = polybench_arena_used;
+  polybench_arena_nb++;
+  *pages = arena_pages;
+
+  return polybench_arena_base + start;
+}
+
+
+static
+int polybench_in_arena(void* ptr)
+{
+  return polybench_arena_base != NULL && (char*) ptr >= polybench_arena_base
+    && (char*) ptr < polybench_arena_base + polybench_arena_sz;
+}
+
+
+/* Called when the last array is freed: release the whole arena. */
+static
+void polybench_arena_release()
+{
+  if (polybench_arena_base == NULL)
+    return;
+  munmap (polybench_arena_base, polybench_arena_sz);
+  polybench_arena_base = NULL;
+  polybench_arena_used = 0;
+  polybench_arena_nb = 0;
+}
+
+
+/* Arrays allocated through polybench_alloc_data, and their total size
+   in bytes (padding excluded). */
+static int polybench_alloc_arrays = 0;
+static unsigned long long polybench_alloc_bytes = 0;
+
+
+/* Report the page and NUMA policies, the anonymous memory of the
+   process backed by transparent huge pages, and the arrays allocated. */
+static
+void polybench_alloc_print_info()
+{
+  char line[256];
+  long thp_kb = -1;
+  FILE* f = fopen ("/proc/self/smaps_rollup", "r");
+  if (f != NULL)
+    {
+      while (fgets (line, sizeof(line), f))
+	if (strncmp (line, "AnonHugePages:", 14) == 0)
+	  thp_kb = atol (line + 14);
+      fclose (f);
+    }
+  printf ("[PolyBench] alloc: alloc=%s alloc_effective=%s",
+	  polybench_pages_names[polybench_get_alloc_policy ()],
+	  polybench_pages_names[polybench_alloc_effective == -1 ?
+				polybench_get_alloc_policy () :
+				polybench_alloc_effective]);
+  if (thp_kb >= 0)
+    printf (" anon_huge_kb=%ld", thp_kb);
+  printf (" alloc_arrays=%d alloc_bytes=%llu\n", polybench_alloc_arrays,
+	  polybench_alloc_bytes);
+  if (polybench_get_numa_policy () == POLYBENCH_NUMA_BIND)
+    printf ("[PolyBench] numa: numa=bind:%d numa_nodes=%d\n",
+	    polybench_numa_node, polybench_numa_nb_nodes);
+  else
+    printf ("[PolyBench] numa: numa=%s numa_nodes=%d\n",
+	    polybench_numa_names[polybench_get_numa_policy ()],
+	    polybench_numa_nb_nodes);
+  if (polybench_use_arena ())
+    printf ("[PolyBench] arena: arena=on arena_align=%zu arena_offset=%zu"
+	    " arena_kb=%zu\n", polybench_arena_align, polybench_arena_offset,
+	    polybench_arena_peak >> 10);
+  else
+    printf ("[PolyBench] arena: arena=off\n");
+  printf ("[PolyBench] padding: padding_factor=%d inter_array_padding=%d\n",
+	  POLYBENCH_PADDING_FACTOR, POLYBENCH_INTER_ARRAY_PADDING_FACTOR);
+}
+
+
+static
+void*
+xmalloc(size_t alloc_sz, void** base, size_t* map_sz, int* pages)
+{
+  void* ret = NULL;
+  /* By default, post-pad the arrays. Safe behavior, but likely useless. */
   polybench_inter_array_padding_sz += POLYBENCH_INTER_ARRAY_PADDING_FACTOR;
-  size_t padded_sz = alloc_sz + polybench_inter_array_padding_sz;
-  int err = posix_memalign (&ret, 4096, padded_sz);
-  if (! ret || err)
+  size_t padded_sz;
+  if (__builtin_add_overflow (alloc_sz, polybench_inter_array_padding_sz,
+			      &padded_sz))
     {
-      fprintf (stderr, "[PolyBench] posix_memalign: cannot allocate memory");
+      fprintf (stderr, "[PolyBench] xmalloc: padded size overflows\n");
       exit (1);
     }
+  *pages = polybench_get_alloc_policy ();
+  if (polybench_use_arena ()
+      && (ret = polybench_arena_alloc (padded_sz, pages)) != NULL)
+    *map_sz = padded_sz;
+  else
+    ret = polybench_alloc_pages (padded_sz, pages, map_sz);
+  if (*pages < polybench_get_alloc_policy ()
+      && polybench_alloc_effective != *pages)
+    printf ("[PolyBench][WARNING] cannot allocate %s pages, using %s\n",
+	    polybench_pages_names[polybench_get_alloc_policy ()],
+	    polybench_pages_names[*pages]);
+  if (polybench_alloc_effective == -1 || *pages < polybench_alloc_effective)
+    polybench_alloc_effective = *pages;
+  *base = ret;
   /* Safeguard: this is invoked only if polybench.c has been compiled
      with inter-array padding support from polybench.h. If so, move
-     the starting address of the allocation and return it to the
-     user. The original pointer is registered in an allocation table
-     internal to polybench.c. Data must then be freed using
-     polybench_free_data, which will inspect the allocation table to
-     free the original pointer.*/
+     the starting address of the allocation by (padded_sz - alloc_sz)
+     bytes and return it to the user. The original pointer is kept in
+     the data registry, from which polybench_free_data frees it. */
 #ifdef POLYBENCH_ENABLE_INTARRAY_PAD
-  /* This moves the 'ret' pointer by (padded_sz - alloc_sz) positions, and
-  registers it in the lookup table for future free using
-  polybench_free_data. */
-  ret = register_padded_pointer(ret, alloc_sz, padded_sz);
+  ret = (char*) ret + (padded_sz - alloc_sz);
 #endif
 
   return ret;
@@ -535,24 +2412,425 @@ xmalloc(size_t alloc_sz)
 
 void polybench_free_data(void* ptr)
 {
-#ifdef POLYBENCH_ENABLE_INTARRAY_PAD
-  free_data_from_alloc_table (ptr);
-#else
-  free (ptr);
-#endif
+  struct polybench_data_entry e;
+  if (! unregister_data (ptr, &e))
+    return;
+  /* Arena arrays go with the arena, after the last one. */
+  if (! polybench_in_arena (e.base))
+    polybench_free_pages (e.base, e.map_sz, e.pages);
+  if (polybench_data_registry_nb == 0)
+    polybench_arena_release ();
 }
 
 
 void* polybench_alloc_data(unsigned long long int n, int elt_size)
 {
-#ifdef POLYBENCH_ENABLE_INTARRAY_PAD
-  check_alloc_table_state ();
-#endif
+  size_t val;
+  if (elt_size <= 0 || __builtin_mul_overflow (n, (size_t) elt_size, &val))
+    {
+      fprintf (stderr, "[PolyBench] polybench_alloc_data: size of %llu"
+	       " elements of %d bytes overflows\n", n, elt_size);
+      exit (1);
+    }
+  void* base;
+  size_t map_sz;
+  int pages;
+  void* ret = xmalloc (val, &base, &map_sz, &pages);
+  if (! polybench_in_arena (base))
+    polybench_numa_place (base, map_sz);
+  register_data (ret, val, base, map_sz, pages);
+  polybench_alloc_arrays++;
+  polybench_alloc_bytes += val;
+
+  return ret;
+}
 
-  /// FIXME: detect overflow!
-  size_t val = n;
-  val *= elt_size;
-  void* ret = xmalloc (val);
+
+/* Allocate an array of nb_dims dimensions (unsigned long long), of
+   elt_size bytes each, and record them in its registry entry. The
+   number of elements, then the size, are checked for overflow. */
+void* polybench_alloc_array(int elt_size, int nb_dims, ...)
+{
+  unsigned long long dims[POLYBENCH_MAX_DIMS], n = 1;
+  struct polybench_data_entry* e;
+  va_list ap;
+  void* ret;
+  int i;
+
+  if (nb_dims < 1 || nb_dims > POLYBENCH_MAX_DIMS)
+    {
+      fprintf (stderr, "[PolyBench] polybench_alloc_array: %d dimensions\n",
+	       nb_dims);
+      exit (1);
+    }
+  va_start (ap, nb_dims);
+  for (i = 0; i < nb_dims; ++i)
+    dims[i] = va_arg (ap, unsigned long long);
+  va_end (ap);
+  for (i = 0; i < nb_dims; ++i)
+    if (__builtin_mul_overflow (n, dims[i], &n))
+      {
+	fprintf (stderr, "[PolyBench] polybench_alloc_array: number of"
+		 " elements of a %d-dimensional array overflows\n", nb_dims);
+	exit (1);
+      }
+  ret = polybench_alloc_data (n, elt_size);
+  e = &_polybench_data_registry[polybench_data_registry_nb - 1];
+  e->nb_dims = nb_dims;
+  memcpy (e->dims, dims, nb_dims * sizeof(dims[0]));
 
   return ret;
 }
+
+
+/*
+ * Dataset cache. When POLYBENCH_DATASET_CACHE names a directory, the
+ * arrays (and the scalars declared with polybench_dataset_scalar) are
+ * written there after initialization, and later executions load them
+ * instead of running the initialization again. A file is identified by
+ * the program source, its data type, padding, array sizes and
+ * dimensions, run-time sizes, and POLYBENCH_DATASET_VERSION, to be
+ * increased whenever an initialization changes. POLYBENCH_DATASET_LOAD
+ * selects how arrays are loaded: mmap (default: the page-aligned arrays
+ * on 4k pages are mapped copy-on-write from the file, and loaded on
+ * first touch; other arrays are copied), or copy (read into the
+ * allocated arrays, which keeps their pages and NUMA placement; the
+ * default under a NUMA policy).
+ *
+ */
+#define POLYBENCH_DATASET_MAGIC "PBDATA"
+#define POLYBENCH_DATASET_ALIGN 4096
+#define POLYBENCH_DATASET_MAX_SCALARS 8
+
+struct polybench_dataset_header
+{
+  char magic[8];
+  unsigned int version;
+  unsigned int nb_arrays;
+  unsigned int nb_scalars;
+  unsigned int pad;
+  unsigned long long key;
+};
+
+static struct { void* ptr; size_t sz; }
+  polybench_dataset_scalars[POLYBENCH_DATASET_MAX_SCALARS];
+static int polybench_dataset_nb_scalars = 0;
+/* -1: no cache, 0: initialized and stored, 1: loaded. */
+static int polybench_dataset_state = -1;
+static int polybench_dataset_mapped = 0;
+static double polybench_dataset_t_begin = 0;
+static double polybench_dataset_time = 0;
+
+
+void polybench_dataset_scalar(void* ptr, size_t sz)
+{
+  if (polybench_dataset_nb_scalars == POLYBENCH_DATASET_MAX_SCALARS)
+    {
+      fprintf (stderr, "[PolyBench] too many dataset scalars\n");
+      exit (1);
+    }
+  polybench_dataset_scalars[polybench_dataset_nb_scalars].ptr = ptr;
+  polybench_dataset_scalars[polybench_dataset_nb_scalars++].sz = sz;
+}
+
+
+static
+unsigned long long polybench_fnv1a(unsigned long long h, const void* p,
+				   size_t sz)
+{
+  const unsigned char* c = (const unsigned char*) p;
+  size_t i;
+  for (i = 0; i < sz; ++i)
+    h = (h ^ c[i]) * 0x100000001b3ULL;
+  return h;
+}
+
+
+/* Cache file of the program: <dir>_<program>_<key>.bin, from the last
+   two components of the source path; 0 if caching is off. */
+static
+int polybench_dataset_path(const char* source, const char* type,
+			   char* path, size_t len, unsigned long long* key)
+{
+  const char* dir = getenv ("POLYBENCH_DATASET_CACHE");
+  const char* name = strrchr (source, '/');
+  const char* parent = source;
+  unsigned long long h = 0xcbf29ce484222325ULL;
+  int i, version = POLYBENCH_DATASET_VERSION, padding = POLYBENCH_PADDING_FACTOR;
+  char prefix[256];
+
+  if (dir == NULL || *dir == '\0')
+    return 0;
+  if (name != NULL)
+    {
+      const char* p;
+      for (p = source; p < name; ++p)
+	if (*p == '/' && p + 1 < name)
+	  parent = p + 1;
+      if (parent[0] == '.' && parent[1] == '/')
+	parent += 2;
+    }
+  snprintf (prefix, sizeof(prefix), "%.*s", (int) strcspn (parent, "."),
+	    parent);
+  for (i = 0; prefix[i]; ++i)
+    if (prefix[i] == '/')
+      prefix[i] = '_';
+
+  h = polybench_fnv1a (h, prefix, strlen (prefix));
+  h = polybench_fnv1a (h, type, strlen (type));
+  h = polybench_fnv1a (h, &version, sizeof(version));
+  h = polybench_fnv1a (h, &padding, sizeof(padding));
+  for (i = 0; i < polybench_data_registry_nb; ++i)
+    {
+      struct polybench_data_entry* e = &_polybench_data_registry[i];
+      h = polybench_fnv1a (h, &e->sz, sizeof(size_t));
+      h = polybench_fnv1a (h, &e->nb_dims, sizeof(int));
+      h = polybench_fnv1a (h, e->dims, e->nb_dims * sizeof(e->dims[0]));
+    }
+  for (i = 0; i < polybench_dataset_nb_scalars; ++i)
+    h = polybench_fnv1a (h, &polybench_dataset_scalars[i].sz, sizeof(size_t));
+#ifdef POLYBENCH_DYNAMIC_SIZES
+  for (i = 0; i < polybench_nb_sizes; ++i)
+    h = polybench_fnv1a (h, &polybench_size_values[i], sizeof(long long));
+#endif
+  *key = h;
+  snprintf (path, len, "%s/%s_%016llx.bin", dir, prefix, h);
+  return 1;
+}
+
+
+static
+double polybench_dataset_clock()
+{
+  struct timespec Tp;
+  clock_gettime (CLOCK_MONOTONIC, &Tp);
+  return (Tp.tv_sec + Tp.tv_nsec * 1.0e-9);
+}
+
+
+/* Read or write exactly sz bytes at offset off of fd. */
+static
+int polybench_dataset_io(int fd, void* ptr, size_t sz, off_t off, int wr)
+{
+  char* p = (char*) ptr;
+  while (sz > 0)
+    {
+      ssize_t n = wr ? pwrite (fd, p, sz, off) : pread (fd, p, sz, off);
+      if (n <= 0)
+	return 0;
+      p += n;
+      off += n;
+      sz -= n;
+    }
+  return 1;
+}
+
+
+/* Read an array from the cache. With the local NUMA policy, the read
+   is the first touch that the skipped initializer would have made: it
+   is split, in page-sized chunks, over the threads, with the static
+   schedule of the initializers, so that each thread's contiguous share
+   of the array lands on its node. */
+static
+int polybench_dataset_read(int fd, void* ptr, size_t sz, off_t off)
+{
+  size_t page = POLYBENCH_DATASET_ALIGN, nb = (sz + page - 1) / page, k;
+  int ok = 1;
+
+  if (polybench_get_numa_policy () != POLYBENCH_NUMA_LOCAL)
+    return polybench_dataset_io (fd, ptr, sz, off, 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) reduction(&&:ok)
+#endif
+  for (k = 0; k < nb; ++k)
+    {
+      size_t len = k == nb - 1 ? sz - k * page : page;
+      ok = ok && polybench_dataset_io (fd, (char*) ptr + k * page, len,
+				       off + k * page, 0);
+    }
+  return ok;
+}
+
+
+/* Arrays are stored in registration order, each at an aligned offset,
+   after the header, the sizes, and the scalars. */
+#define POLYBENCH_DATASET_ALIGN_UP(off) \
+  (((off) + POLYBENCH_DATASET_ALIGN - 1) / POLYBENCH_DATASET_ALIGN \
+   * POLYBENCH_DATASET_ALIGN)
+
+
+int polybench_dataset_load(const char* source, const char* type)
+{
+  struct polybench_dataset_header h;
+  char path[4096];
+  unsigned long long key, sz;
+  const char* mode = getenv ("POLYBENCH_DATASET_LOAD");
+  int use_mmap = mode != NULL && *mode ? strcmp (mode, "mmap") == 0
+    : polybench_get_numa_policy () == POLYBENCH_NUMA_NONE;
+  off_t off;
+  int fd, i, ok;
+
+  polybench_dataset_t_begin = polybench_dataset_clock ();
+  if (! polybench_dataset_path (source, type, path, sizeof(path), &key))
+    return 0;
+  polybench_dataset_state = 0;
+  fd = open (path, O_RDONLY);
+  if (fd < 0)
+    return 0;
+  ok = polybench_dataset_io (fd, &h, sizeof(h), 0, 0)
+    && memcmp (h.magic, POLYBENCH_DATASET_MAGIC, sizeof(POLYBENCH_DATASET_MAGIC)) == 0
+    && h.version == POLYBENCH_DATASET_VERSION && h.key == key
+    && h.nb_arrays == (unsigned int) polybench_data_registry_nb
+    && h.nb_scalars == (unsigned int) polybench_dataset_nb_scalars;
+  off = sizeof(h);
+  for (i = 0; ok && i < polybench_data_registry_nb; ++i, off += sizeof(sz))
+    ok = polybench_dataset_io (fd, &sz, sizeof(sz), off, 0)
+      && sz == _polybench_data_registry[i].sz;
+  for (i = 0; ok && i < polybench_dataset_nb_scalars; ++i)
+    {
+      ok = polybench_dataset_io (fd, polybench_dataset_scalars[i].ptr,
+				 polybench_dataset_scalars[i].sz, off, 0);
+      off += polybench_dataset_scalars[i].sz;
+    }
+  for (i = 0; ok && i < polybench_data_registry_nb; ++i)
+    {
+      struct polybench_data_entry* e = &_polybench_data_registry[i];
+      size_t mapped = 0;
+      off = POLYBENCH_DATASET_ALIGN_UP (off);
+      /* Arrays on 4k pages are anonymous mappings of their own or of
+	 the arena, which the file mapping replaces in part, and which
+	 are unmapped as a whole; transparent huge pages are owned by
+	 malloc, and hugetlb ones would lose their pages. Only whole
+	 pages of the array are mapped: the rest of its last page may
+	 belong to other arrays. */
+      if (use_mmap && e->pages == POLYBENCH_PAGES_4K
+	  && (size_t) e->ptr % POLYBENCH_DATASET_ALIGN == 0)
+	{
+	  mapped = e->sz / POLYBENCH_DATASET_ALIGN * POLYBENCH_DATASET_ALIGN;
+	  if (mapped > 0
+	      && mmap (e->ptr, mapped, PROT_READ | PROT_WRITE,
+		       MAP_PRIVATE | MAP_FIXED, fd, off) == MAP_FAILED)
+	    mapped = 0;
+	  if (mapped > 0)
+	    polybench_dataset_mapped++;
+	}
+      ok = polybench_dataset_read (fd, (char*) e->ptr + mapped,
+				   e->sz - mapped, off + mapped);
+      off += e->sz;
+    }
+  close (fd);
+  if (! ok)
+    {
+      printf ("[PolyBench][WARNING] invalid dataset cache %s, initializing\n",
+	      path);
+      return 0;
+    }
+  polybench_dataset_state = 1;
+  polybench_dataset_time = polybench_dataset_clock () - polybench_dataset_t_begin;
+
+  return 1;
+}
+
+
+void polybench_dataset_store(const char* source, const char* type)
+{
+  struct polybench_dataset_header h;
+  char path[4096], tmp[4200];
+  unsigned long long key, sz;
+  off_t off;
+  int fd, i, ok;
+
+  polybench_dataset_time = polybench_dataset_clock () - polybench_dataset_t_begin;
+  if (! polybench_dataset_path (source, type, path, sizeof(path), &key))
+    return;
+  mkdir (getenv ("POLYBENCH_DATASET_CACHE"), 0755);
+  /* Written aside and renamed, so that concurrent runs never read a
+     partial file. */
+  snprintf (tmp, sizeof(tmp), "%s.%d.tmp", path, (int) getpid ());
+  fd = open (tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0)
+    {
+      printf ("[PolyBench][WARNING] cannot write dataset cache %s\n", tmp);
+      return;
+    }
+  memset (&h, 0, sizeof(h));
+  memcpy (h.magic, POLYBENCH_DATASET_MAGIC, sizeof(POLYBENCH_DATASET_MAGIC));
+  h.version = POLYBENCH_DATASET_VERSION;
+  h.nb_arrays = polybench_data_registry_nb;
+  h.nb_scalars = polybench_dataset_nb_scalars;
+  h.key = key;
+  ok = polybench_dataset_io (fd, &h, sizeof(h), 0, 1);
+  off = sizeof(h);
+  for (i = 0; ok && i < polybench_data_registry_nb; ++i, off += sizeof(sz))
+    {
+      sz = _polybench_data_registry[i].sz;
+      ok = polybench_dataset_io (fd, &sz, sizeof(sz), off, 1);
+    }
+  for (i = 0; ok && i < polybench_dataset_nb_scalars; ++i)
+    {
+      ok = polybench_dataset_io (fd, polybench_dataset_scalars[i].ptr,
+				 polybench_dataset_scalars[i].sz, off, 1);
+      off += polybench_dataset_scalars[i].sz;
+    }
+  for (i = 0; ok && i < polybench_data_registry_nb; ++i)
+    {
+      off = POLYBENCH_DATASET_ALIGN_UP (off);
+      ok = polybench_dataset_io (fd, _polybench_data_registry[i].ptr,
+				 _polybench_data_registry[i].sz, off, 1);
+      off += _polybench_data_registry[i].sz;
+    }
+  if (close (fd) != 0 || ! ok || rename (tmp, path) != 0)
+    {
+      printf ("[PolyBench][WARNING] cannot write dataset cache %s\n", path);
+      unlink (tmp);
+    }
+}
+
+
+/* Checksum of the initialized data, with POLYBENCH_CHECKSUM=1: equal
+   checksums show that two builds (directories, compilers, numbers of
+   threads, cached or not) start from the same data. */
+static int polybench_dataset_checksummed = 0;
+static unsigned long long polybench_dataset_sum = 0;
+
+void polybench_dataset_checksum()
+{
+  unsigned long long h = 0xcbf29ce484222325ULL;
+  int i;
+
+  if (! polybench_env_int ("POLYBENCH_CHECKSUM", 0))
+    return;
+  for (i = 0; i < polybench_dataset_nb_scalars; ++i)
+    h = polybench_fnv1a (h, polybench_dataset_scalars[i].ptr,
+			 polybench_dataset_scalars[i].sz);
+  for (i = 0; i < polybench_data_registry_nb; ++i)
+    {
+      /* FNV-1a over 8-byte words, then the remaining bytes. */
+      const unsigned long long* w =
+	(const unsigned long long*) _polybench_data_registry[i].ptr;
+      size_t n = _polybench_data_registry[i].sz / sizeof(*w), k;
+      for (k = 0; k < n; ++k)
+	h = (h ^ w[k]) * 0x100000001b3ULL;
+      h = polybench_fnv1a (h, w + n,
+			   _polybench_data_registry[i].sz % sizeof(*w));
+    }
+  polybench_dataset_sum = h;
+  polybench_dataset_checksummed = 1;
+}
+
+
+static
+void polybench_dataset_print_info()
+{
+  if (polybench_dataset_checksummed)
+    printf ("[PolyBench] init: init_checksum=%016llx\n",
+	    polybench_dataset_sum);
+  if (polybench_dataset_state == -1)
+    return;
+  printf ("[PolyBench] dataset: dataset=%s dataset_time=%0.6f",
+	  polybench_dataset_state ? "loaded" : "stored",
+	  polybench_dataset_time);
+  if (polybench_dataset_state)
+    printf (" dataset_mapped=%d", polybench_dataset_mapped);
+  printf ("\n");
+}
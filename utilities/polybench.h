@@ -19,6 +19,40 @@
  * -DPOLYBENCH_TIME, to report the execution time,
  *   OR (exclusive):
  * -DPOLYBENCH_PAPI, to use PAPI H/W counters (defined in polybench.c)
+ *   OR (exclusive):
+ * -DPOLYBENCH_PERF, to read H/W counters with Linux perf_event_open,
+ *   all in a single execution of the kernel
+ *
+ * -DPOLYBENCH_REPEAT, with -DPOLYBENCH_TIME, to run the kernel several
+ *   times in a single process and report median, MAD and min times.
+ *
+ * -DPOLYBENCH_MONOTONIC_TIMER, with -DPOLYBENCH_TIME, to measure time with
+ *   clock_gettime(CLOCK_MONOTONIC_RAW) at nanosecond resolution, minus
+ *   the calibrated cost of a timer read.
+ *
+ * -DPOLYBENCH_CYCLE_ACCURATE_TIMER, with -DPOLYBENCH_TIME, to measure with
+ *   serialized RDTSC/RDTSCP reads (x86 only); cycles are converted to
+ *   seconds with the TSC frequency calibrated at startup.
+ *
+ * -DPOLYBENCH_OMPT, to let an OMPT tool (utilities/ompt_tool.c) measure
+ *   the OpenMP runtime only while the kernel runs, via omp_control_tool.
+ *
+ * -DPOLYBENCH_ALLOC_POLICY=thp (or 4k, 2m, 1g), to allocate arrays on
+ *   transparent or explicit huge pages; see POLYBENCH_ALLOC in polybench.c.
+ *
+ * -DPOLYBENCH_DYNAMIC_SIZES, to read the problem sizes at run time, from
+ *   the command line or the environment; see POLYBENCH_DYNAMIC_SIZE.
+ *
+ * -DPOLYBENCH_ARENA, to allocate all arrays from a single arena, at
+ *   relative offsets set by POLYBENCH_ARENA_ALIGN and POLYBENCH_ARENA_OFFSET.
+ *
+ * -DPOLYBENCH_RUSAGE, with -DPOLYBENCH_TIME, to report the page faults,
+ *   context switches and CPU times of the timed kernel, and the peak
+ *   resident memory, read with getrusage.
+ *
+ * -DPOLYBENCH_TRACE, to record the regions marked with
+ *   polybench_trace_begin/end on each thread, and write them at exit as
+ *   a Chrome trace JSON file (POLYBENCH_TRACE_FILE).
  *
  *
  * See README or utilities/polybench.c for additional options.
@@ -45,6 +79,20 @@
 # endif
 
 
+/* Type of the problem sizes and loop indices of the kernels. By
+   default, int; long with -DPOLYBENCH_USE_LONG_INDEX, and always for
+   HUGE_DATASET, whose sizes exceed INT_MAX. Must be signed: some loops
+   count down to 0. */
+# ifndef INDEX_TYPE
+#  if defined(POLYBENCH_USE_LONG_INDEX) || defined(HUGE_DATASET)
+#   define INDEX_TYPE long
+#  else
+/* default: */
+#   define INDEX_TYPE int
+#  endif
+# endif
+
+
 /* C99 arrays in function prototype. By default, do not use. */
 # ifdef POLYBENCH_USE_C99_PROTO
 #  define POLYBENCH_C99_SELECT(x,y) y
@@ -82,11 +130,7 @@
 */
 # ifndef POLYBENCH_STACK_ARRAYS
 #  define POLYBENCH_ARRAY(x) *x
-#  ifdef POLYBENCH_ENABLE_INTARRAY_PAD
-#   define POLYBENCH_FREE_ARRAY(x) polybench_free_data((void*)x);
-#  else
-#   define POLYBENCH_FREE_ARRAY(x) free((void*)x);
-#  endif
+#  define POLYBENCH_FREE_ARRAY(x) polybench_free_data((void*)x);
 #  define POLYBENCH_DECL_VAR(x) (*x)
 # else
 #  define POLYBENCH_ARRAY(x) x
@@ -111,17 +155,19 @@
    Example:
    polybench_alloc_2d_array(N, M, double) => allocates N x M x sizeof(double)
 					  and returns a pointer to the 2d array
+   The dimensions are passed to polybench_alloc_array, which computes
+   the size and records them (e.g. for the dataset cache).
  */
 # define POLYBENCH_ALLOC_1D_ARRAY(n1, type)	\
-  (type(*)[n1 + POLYBENCH_PADDING_FACTOR])polybench_alloc_data (n1 + POLYBENCH_PADDING_FACTOR, sizeof(type))
-# define POLYBENCH_ALLOC_2D_ARRAY(n1, n2, type)		\
-  (type(*)[n1 + POLYBENCH_PADDING_FACTOR][n2 + POLYBENCH_PADDING_FACTOR])polybench_alloc_data ((n1 + POLYBENCH_PADDING_FACTOR) * (n2 + POLYBENCH_PADDING_FACTOR), sizeof(type))
-# define POLYBENCH_ALLOC_3D_ARRAY(n1, n2, n3, type)		\
-  (type(*)[n1 + POLYBENCH_PADDING_FACTOR][n2 + POLYBENCH_PADDING_FACTOR][n3 + POLYBENCH_PADDING_FACTOR])polybench_alloc_data ((n1 + POLYBENCH_PADDING_FACTOR) * (n2 + POLYBENCH_PADDING_FACTOR) * (n3 + POLYBENCH_PADDING_FACTOR), sizeof(type))
-# define POLYBENCH_ALLOC_4D_ARRAY(n1, n2, n3, n4, type)			\
-  (type(*)[n1 + POLYBENCH_PADDING_FACTOR][n2 + POLYBENCH_PADDING_FACTOR][n3 + POLYBENCH_PADDING_FACTOR][n4 + POLYBENCH_PADDING_FACTOR])polybench_alloc_data ((n1 + POLYBENCH_PADDING_FACTOR) * (n2 + POLYBENCH_PADDING_FACTOR) * (n3 + POLYBENCH_PADDING_FACTOR) * (n4 + POLYBENCH_PADDING_FACTOR), sizeof(type))
-# define POLYBENCH_ALLOC_5D_ARRAY(n1, n2, n3, n4, n5, type)		\
-  (type(*)[n1 + POLYBENCH_PADDING_FACTOR][n2 + POLYBENCH_PADDING_FACTOR][n3 + POLYBENCH_PADDING_FACTOR][n4 + POLYBENCH_PADDING_FACTOR][n5 + POLYBENCH_PADDING_FACTOR])polybench_alloc_data ((n1 + POLYBENCH_PADDING_FACTOR) * (n2 + POLYBENCH_PADDING_FACTOR) * (n3 + POLYBENCH_PADDING_FACTOR) * (n4 + POLYBENCH_PADDING_FACTOR) * (n5 + POLYBENCH_PADDING_FACTOR), sizeof(type))
+  (type(*)[n1 + POLYBENCH_PADDING_FACTOR])polybench_alloc_array (sizeof(type), 1, (unsigned long long) (n1 + POLYBENCH_PADDING_FACTOR))
+# define POLYBENCH_ALLOC_2D_ARRAY(n1, n2, type)	\
+  (type(*)[n1 + POLYBENCH_PADDING_FACTOR][n2 + POLYBENCH_PADDING_FACTOR])polybench_alloc_array (sizeof(type), 2, (unsigned long long) (n1 + POLYBENCH_PADDING_FACTOR), (unsigned long long) (n2 + POLYBENCH_PADDING_FACTOR))
+# define POLYBENCH_ALLOC_3D_ARRAY(n1, n2, n3, type)	\
+  (type(*)[n1 + POLYBENCH_PADDING_FACTOR][n2 + POLYBENCH_PADDING_FACTOR][n3 + POLYBENCH_PADDING_FACTOR])polybench_alloc_array (sizeof(type), 3, (unsigned long long) (n1 + POLYBENCH_PADDING_FACTOR), (unsigned long long) (n2 + POLYBENCH_PADDING_FACTOR), (unsigned long long) (n3 + POLYBENCH_PADDING_FACTOR))
+# define POLYBENCH_ALLOC_4D_ARRAY(n1, n2, n3, n4, type)	\
+  (type(*)[n1 + POLYBENCH_PADDING_FACTOR][n2 + POLYBENCH_PADDING_FACTOR][n3 + POLYBENCH_PADDING_FACTOR][n4 + POLYBENCH_PADDING_FACTOR])polybench_alloc_array (sizeof(type), 4, (unsigned long long) (n1 + POLYBENCH_PADDING_FACTOR), (unsigned long long) (n2 + POLYBENCH_PADDING_FACTOR), (unsigned long long) (n3 + POLYBENCH_PADDING_FACTOR), (unsigned long long) (n4 + POLYBENCH_PADDING_FACTOR))
+# define POLYBENCH_ALLOC_5D_ARRAY(n1, n2, n3, n4, n5, type)	\
+  (type(*)[n1 + POLYBENCH_PADDING_FACTOR][n2 + POLYBENCH_PADDING_FACTOR][n3 + POLYBENCH_PADDING_FACTOR][n4 + POLYBENCH_PADDING_FACTOR][n5 + POLYBENCH_PADDING_FACTOR])polybench_alloc_array (sizeof(type), 5, (unsigned long long) (n1 + POLYBENCH_PADDING_FACTOR), (unsigned long long) (n2 + POLYBENCH_PADDING_FACTOR), (unsigned long long) (n3 + POLYBENCH_PADDING_FACTOR), (unsigned long long) (n4 + POLYBENCH_PADDING_FACTOR), (unsigned long long) (n5 + POLYBENCH_PADDING_FACTOR))
 
 /* Macros for array declaration. */
 # ifndef POLYBENCH_STACK_ARRAYS
@@ -204,6 +250,20 @@ extern const unsigned int polybench_papi_eventlist[];
 # endif
 
 
+/* perf_event_open support: all counters are read in one kernel run. */
+# ifdef POLYBENCH_PERF
+#  undef polybench_start_instruments
+#  undef polybench_stop_instruments
+#  undef polybench_print_instruments
+#  define polybench_start_instruments polybench_perf_start();
+#  define polybench_stop_instruments polybench_perf_stop();
+#  define polybench_print_instruments polybench_perf_print();
+extern void polybench_perf_start();
+extern void polybench_perf_stop();
+extern void polybench_perf_print();
+# endif
+
+
 /* Timing support. */
 # if defined(POLYBENCH_TIME) || defined(POLYBENCH_GFLOPS)
 #  undef polybench_start_instruments
@@ -212,12 +272,49 @@ extern const unsigned int polybench_papi_eventlist[];
 #  define polybench_start_instruments polybench_timer_start();
 #  define polybench_stop_instruments polybench_timer_stop();
 #  define polybench_print_instruments polybench_timer_print();
-extern double polybench_program_total_flops;
 extern void polybench_timer_start();
 extern void polybench_timer_stop();
 extern void polybench_timer_print();
 # endif
 
+/* Work and memory traffic of one kernel execution, from the models
+   POLYBENCH_PROGRAM_FLOPS and POLYBENCH_PROGRAM_BYTES of the benchmark
+   headers: reported with the time, and used by POLYBENCH_GFLOPS. Both
+   models count the kernel as written in the original version, so that
+   the versions of a program are compared on the same work: flops are
+   its floating-point operations, and bytes the arrays it reads and
+   writes, each counted once per pass over it (no cache reuse). */
+# define polybench_set_program_flops(value) \
+  polybench_program_total_flops = (value)
+# define polybench_set_program_bytes(value) \
+  polybench_program_total_bytes = (value)
+extern double polybench_program_total_flops;
+extern double polybench_program_total_bytes;
+
+/* Repetition support. The kernel is run in a loop; arrays are restored
+   from a snapshot of their initialized state before each repetition. */
+# if defined(POLYBENCH_REPEAT) && defined(POLYBENCH_TIME)
+#  undef polybench_start_instruments
+#  undef polybench_stop_instruments
+#  undef polybench_print_instruments
+#  define polybench_start_instruments				\
+  polybench_repeat_init();					\
+  while (polybench_repeat_next())				\
+    {								\
+      polybench_timer_start();
+
+#  define polybench_stop_instruments		\
+      polybench_timer_stop();			\
+      polybench_repeat_record();		\
+    }
+
+#  define polybench_print_instruments polybench_repeat_print();
+extern void polybench_repeat_init();
+extern int polybench_repeat_next();
+extern void polybench_repeat_record();
+extern void polybench_repeat_print();
+# endif
+
 /* PAPI support. */
 # ifdef POLYBENCH_PAPI
 extern int polybench_papi_start_counter(int evid);
@@ -227,8 +324,67 @@ extern void polybench_papi_close();
 extern void polybench_papi_print();
 # endif
 
+/* Region tracing. Mark a named region of the calling thread with
+   polybench_trace_begin("name"); ... polybench_trace_end("name");
+   the name must be a string literal. See polybench.c */
+# ifdef POLYBENCH_TRACE
+#  define polybench_trace_begin(name) polybench_trace_event(name, 'B')
+#  define polybench_trace_end(name) polybench_trace_event(name, 'E')
+extern void polybench_trace_event(const char* name, char phase);
+# else
+#  define polybench_trace_begin(name)
+#  define polybench_trace_end(name)
+# endif
+
+/* Run-time problem sizes. With -DPOLYBENCH_DYNAMIC_SIZES, each size
+   declared with POLYBENCH_DYNAMIC_SIZE in a benchmark header becomes a
+   variable, read before main from the command line (e.g. N=1000) or
+   the environment (POLYBENCH_SIZE_N=1000); it defaults to the value of
+   the dataset selected at build time. See polybench.c */
+# ifdef POLYBENCH_DYNAMIC_SIZES
+#  define POLYBENCH_DYNAMIC_SIZE(dim)					\
+  static INDEX_TYPE polybench_size_##dim = dim;				\
+  __attribute__((constructor))						\
+  static void polybench_init_size_##dim()				\
+  {									\
+    polybench_size_##dim = (INDEX_TYPE)					\
+      polybench_dynamic_size (#dim, dim, sizeof(INDEX_TYPE));		\
+  }
+extern long long polybench_dynamic_size(const char* name, long long def,
+					int index_size);
+# else
+#  define POLYBENCH_DYNAMIC_SIZE(dim)
+# endif
+
+/* Dataset cache: run the initialization init, or load the arrays it
+   initialized from POLYBENCH_DATASET_CACHE. Scalars set by init must be
+   declared first with polybench_dataset_scalar. The data is then
+   checksummed if POLYBENCH_CHECKSUM is set. See polybench.c */
+# define POLYBENCH_DATASET_STR(x) #x
+# define POLYBENCH_DATASET_XSTR(x) POLYBENCH_DATASET_STR(x)
+# ifndef POLYBENCH_STACK_ARRAYS
+#  define polybench_cached_init(init)					\
+  do {									\
+    if (! polybench_dataset_load (__FILE__,				\
+				  POLYBENCH_DATASET_XSTR(DATA_TYPE)))	\
+      {									\
+	init;								\
+	polybench_dataset_store (__FILE__,				\
+				 POLYBENCH_DATASET_XSTR(DATA_TYPE));	\
+      }									\
+    polybench_dataset_checksum ();					\
+  } while (0)
+# else
+#  define polybench_cached_init(init) init
+# endif
+extern int polybench_dataset_load(const char* source, const char* type);
+extern void polybench_dataset_store(const char* source, const char* type);
+extern void polybench_dataset_scalar(void* ptr, size_t sz);
+extern void polybench_dataset_checksum();
+
 /* Function prototypes. */
 extern void* polybench_alloc_data(unsigned long long int n, int elt_size);
+extern void* polybench_alloc_array(int elt_size, int nb_dims, ...);
 extern void polybench_free_data(void* ptr);
 
 /* PolyBench internal functions that should not be directly called by */
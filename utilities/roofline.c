@@ -0,0 +1,144 @@
+/**
+ * roofline.c: machine ceilings for the roofline report of plot.py.
+ *
+ * Measures, with all OpenMP threads, the sustainable memory bandwidth
+ * with the STREAM triad kernel (a[i] = b[i] + s * c[i], counted as 3
+ * arrays moved per element, as in STREAM), and the peak double
+ * precision rate with independent multiply-add chains held in
+ * registers. Build it for the machine, as the benchmarks are run:
+ *
+ *   cc -O3 -march=native -fopenmp utilities/roofline.c -o roofline
+ *   ./roofline [elements per array, default 2^25] > eval/roofline.txt
+ *
+ * Each measure is the best of ROOFLINE_REPS runs, printed as:
+ *
+ *   [PolyBench] roofline: peak_gflops=... peak_gbs=... threads=...
+ *
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#ifdef _OPENMP
+# include <omp.h>
+#endif
+
+#define ROOFLINE_REPS 10
+/* Independent accumulators per thread, enough to cover the latency of
+   the multiply-add units with the widest vectors. */
+#define ROOFLINE_CHAINS 64
+/* Multiply-adds per chain and per run. */
+#define ROOFLINE_FLOP_ITERS 5000000L
+
+
+static
+double roofline_clock()
+{
+  struct timespec Tp;
+  clock_gettime (CLOCK_MONOTONIC, &Tp);
+  return (Tp.tv_sec + Tp.tv_nsec * 1.0e-9);
+}
+
+
+static
+double roofline_bandwidth(long n)
+{
+  double* a = (double*) malloc (n * sizeof(double));
+  double* b = (double*) malloc (n * sizeof(double));
+  double* c = (double*) malloc (n * sizeof(double));
+  double best = 0, s = 3.0;
+  long i;
+  int r;
+
+  if (a == NULL || b == NULL || c == NULL)
+    {
+      fprintf (stderr, "[PolyBench] roofline: not enough memory\n");
+      exit (1);
+    }
+  /* First touch with the schedule of the triad. */
+#pragma omp parallel for schedule(static)
+  for (i = 0; i < n; i++)
+    {
+      a[i] = 0;
+      b[i] = 1;
+      c[i] = 2;
+    }
+  for (r = 0; r < ROOFLINE_REPS; r++)
+    {
+      double t = roofline_clock ();
+#pragma omp parallel for simd schedule(static)
+      for (i = 0; i < n; i++)
+	a[i] = b[i] + s * c[i];
+      t = roofline_clock () - t;
+      if (t > 0 && 3.0 * sizeof(double) * n / t > best)
+	best = 3.0 * sizeof(double) * n / t;
+    }
+  /* Keep the triad live. */
+  if (a[n / 2] != 7.0)
+    fprintf (stderr, "[PolyBench] roofline: unexpected triad result\n");
+  free (a);
+  free (b);
+  free (c);
+  return best;
+}
+
+
+static
+double roofline_flops()
+{
+  double best = 0, sink = 0;
+  int r;
+
+  for (r = 0; r < ROOFLINE_REPS; r++)
+    {
+      double t = roofline_clock ();
+      int threads = 1;
+#pragma omp parallel reduction(+:sink)
+      {
+	double x[ROOFLINE_CHAINS];
+	double m = 0.999999, c = 1.0e-7;
+	long it;
+	int k;
+#ifdef _OPENMP
+#pragma omp single
+	threads = omp_get_num_threads ();
+#endif
+	for (k = 0; k < ROOFLINE_CHAINS; k++)
+	  x[k] = k;
+	for (it = 0; it < ROOFLINE_FLOP_ITERS; it++)
+#pragma omp simd
+	  for (k = 0; k < ROOFLINE_CHAINS; k++)
+	    x[k] = x[k] * m + c;
+	for (k = 0; k < ROOFLINE_CHAINS; k++)
+	  sink += x[k];
+      }
+      t = roofline_clock () - t;
+      double flops = 2.0 * threads * ROOFLINE_CHAINS * ROOFLINE_FLOP_ITERS;
+      if (t > 0 && flops / t > best)
+	best = flops / t;
+    }
+  if (sink == 0)
+    fprintf (stderr, "[PolyBench] roofline: unexpected flop result\n");
+  return best;
+}
+
+
+int main(int argc, char** argv)
+{
+  long n = argc > 1 ? atol (argv[1]) : 1L << 25;
+  int threads = 1;
+
+  if (n <= 0)
+    {
+      fprintf (stderr, "usage: %s [elements per array]\n", argv[0]);
+      return 1;
+    }
+#ifdef _OPENMP
+  threads = omp_get_max_threads ();
+#endif
+  double gbs = roofline_bandwidth (n) / 1.0e9;
+  double gflops = roofline_flops () / 1.0e9;
+  printf ("[PolyBench] roofline: peak_gflops=%0.3f peak_gbs=%0.3f threads=%d\n",
+	  gflops, gbs, threads);
+
+  return 0;
+}
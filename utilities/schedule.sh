@@ -0,0 +1,103 @@
+#!/usr/bin/env bash
+
+# Randomized, interleaved benchmark scheduler.
+#
+# Running all of original, then all of fission, then all of alt makes
+# thermal drift, turbo budget and background load correlate with the
+# source directory, which biases the speedups. This script builds the
+# full matrix of (program, data size, optimization level) blocks, and
+# runs the blocks in an order shuffled with a seed; within a block, the
+# source directories run back to back, in an order rotated from block
+# to block (round-robin), so that each comes first equally often.
+#
+# Each cell is one run.sh -p execution. Results go to eval/results as
+# usual, and, in run order with a line per block, to
+# eval/schedule/seed_<seed>.txt, from which plot.py -d paired computes
+# speedups of the samples of each block. Rounds reshuffle the blocks; a
+# given seed gives the same order with the same awk.
+#
+# basic usage:
+# ./utilities/schedule.sh -S 42 -r 3 -s "SMALL MEDIUM" -o "O2 O3"
+#
+# other run.sh arguments follow --, e.g. -- -y -t 4
+
+
+# parse command line args
+while getopts c:d:s:o:p:r:S: flag
+do
+    case "${flag}" in
+        c) compiler=${OPTARG};;
+        d) directories=${OPTARG};;
+        s) sizes=${OPTARG};;
+        o) opt_levels=${OPTARG};;
+        p) progs=${OPTARG};;
+        r) rounds=${OPTARG};;
+        S) seed=${OPTARG};;
+        *) ;;
+    esac
+done
+shift $((OPTIND - 1))
+RUN_ARGS=("$@")                             # passed on to run.sh
+
+CC="${compiler:-gcc}"                       # compiler, default: gcc
+DIRS=(${directories:-original fission alt}) # source directories
+SIZES=(${sizes:-MINI SMALL MEDIUM LARGE EXTRALARGE})
+OPTS=(${opt_levels:-O0 O1 O2 O3})
+ROUNDS=${rounds:-1}                         # shuffled passes over the matrix
+SEED=${seed:-$(date '+%s')}                 # seed of the order, default: time
+
+# programs: all of the first directory, by default
+if [ -n "$progs" ]; then
+    PROGS=($progs)
+else
+    PROGS=()
+    for file in ./"${DIRS[0]}"/*.c; do
+        filename=$(basename -- "$file")
+        PROGS+=("${filename%.*}")
+    done
+fi
+
+if [[ ! $ROUNDS =~ ^[1-9][0-9]*$ || ! $SEED =~ ^[0-9]+$ ]]; then
+    echo "[ERROR]: rounds (-r) and seed (-S) must be positive integers"
+    exit 1;
+fi
+
+SCHED_DIR="eval/schedule"
+LOG=./"$SCHED_DIR"/seed_"$SEED".txt
+[ -d "$SCHED_DIR" ] || mkdir -p "$SCHED_DIR"
+
+# the blocks, one per line: size opt program
+blocks=()
+for size in "${SIZES[@]}"; do
+    for opt in "${OPTS[@]}"; do
+        for prog in "${PROGS[@]}"; do
+            blocks+=("$size $opt $prog")
+        done
+    done
+done
+
+total=$(( ${#blocks[@]} * ROUNDS ))
+echo "schedule: seed $SEED, $ROUNDS round(s) of ${#blocks[@]} blocks of ${#DIRS[@]} directories"
+echo "# seed $SEED rounds $ROUNDS directories ${DIRS[*]} args ${RUN_ARGS[*]}" >> "$LOG"
+
+n=0
+for (( round=1 ; round<=ROUNDS ; round++ )); do
+
+    # shuffle the blocks, seeded by the seed and the round
+    order=$(printf '%s\n' "${blocks[@]}" \
+            | awk -v s="$((SEED + round))" 'BEGIN { srand(s) } { print rand() "\t" $0 }' \
+            | sort -n -k1,1 | cut -f2-)
+
+    while read -r size opt prog; do
+        n=$((n + 1))
+        echo "# block $n/$total round $round: $size $opt $prog" >> "$LOG"
+
+        # source directories, rotated by one per block
+        for (( k=0 ; k<${#DIRS[@]} ; k++ )); do
+            dir=${DIRS[$(( (n + k) % ${#DIRS[@]} ))]}
+            ./run.sh -c "$CC" -d "$dir" -s "$size" -o "$opt" -p "$prog" -S "$SEED" "${RUN_ARGS[@]}" || exit 1
+        done
+    done <<< "$order"
+done
+
+echo "schedule: done, results in run order in $LOG"
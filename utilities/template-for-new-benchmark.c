@@ -13,9 +13,9 @@
 
 /* Array initialization. */
 static
-void init_array(int n, DATA_TYPE POLYBENCH_2D(C,N,N,n,n))
+void init_array(INDEX_TYPE n, DATA_TYPE POLYBENCH_2D(C,N,N,n,n))
 {
-  int i, j;
+  INDEX_TYPE i, j;
 
   for (i = 0; i < n; i++)
     for (j = 0; j < n; j++)
@@ -26,9 +26,9 @@ void init_array(int n, DATA_TYPE POLYBENCH_2D(C,N,N,n,n))
 /* DCE code. Must scan the entire live-out data.
    Can be used also to check the correctness of the output. */
 static
-void print_array(int n, DATA_TYPE POLYBENCH_2D(C,N,N,n,n))
+void print_array(INDEX_TYPE n, DATA_TYPE POLYBENCH_2D(C,N,N,n,n))
 {
-  int i, j;
+  INDEX_TYPE i, j;
 
   for (i = 0; i < n; i++)
     for (j = 0; j < n; j++) {
@@ -42,9 +42,9 @@ void print_array(int n, DATA_TYPE POLYBENCH_2D(C,N,N,n,n))
 /* Main computational kernel. The whole function will be timed,
    including the call and return. */
 static
-void kernel_template(int n, DATA_TYPE POLYBENCH_2D(C,N,N,n,n))
+void kernel_template(INDEX_TYPE n, DATA_TYPE POLYBENCH_2D(C,N,N,n,n))
 {
-  int i, j;
+  INDEX_TYPE i, j;
 
 #pragma scop
   for (i = 0; i < _PB_N; i++)
@@ -58,7 +58,7 @@ void kernel_template(int n, DATA_TYPE POLYBENCH_2D(C,N,N,n,n))
 int main(int argc, char** argv)
 {
   /* Retrieve problem size. */
-  int n = N;
+  INDEX_TYPE n = N;
 
   /* Variable declaration/allocation. */
   POLYBENCH_2D_ARRAY_DECL(C,DATA_TYPE,N,N,n,n);
@@ -23,7 +23,7 @@ compute_mean_exec_time()
 {
     file="$1";
     benchcomputed="$2";
-    cat "$file" | grep "[0-9]\+" | sort -n | head -n 4 | tail -n 3 > avg.out;
+    cat "$file" | grep -v "^\[" | grep "[0-9]\+" | sort -n | head -n 4 | tail -n 3 > avg.out;
     expr="(0";
     while read n; do
 	expr="$expr+$n";
@@ -63,16 +63,48 @@ compute_mean_exec_time()
     rm -f avg.out;
 }
 
+## Programs compiled with -DPOLYBENCH_REPEAT time the kernel several
+## times in one process, and report the statistics on a line
+## "[PolyBench] repeat: reps=.. median=.. mad=.. min=..". Use the median
+## as time, and the median absolute deviation (in %) as variance.
+compute_repeat_exec_time()
+{
+    file="$1";
+    stats=`grep "^\[PolyBench\] repeat:" "$file" | tail -n 1`;
+    time=`echo "$stats" | sed -n 's/.* median=\([^ ]*\).*/\1/p'`;
+    mad=`echo "$stats" | sed -n 's/.* mad=\([^ ]*\).*/\1/p'`;
+    variance=`echo "$time $mad" | awk '{ if ($1 > 0) printf "%.5f", ($2 / $1) * 100; else printf "%.5f", 0; }'`;
+    PROCESSED_TIME="$time";
+}
+
+## Every "[PolyBench] <report>: key=value ..." line is forwarded as
+## tab-separated key=value fields, after the time.
+collect_reports()
+{
+    file="$1";
+    grep "^\[PolyBench\] [a-z_-]*:" "$file" | sed 's/^\[PolyBench\] [a-z_-]*://' | tr -s ' \t' '\n' | grep "=" | tr '\n' '\t' | sed 's/\t$//';
+}
+
 #echo "[INFO] Running 5 times $1..."
 #echo "[INFO] Maximal variance authorized on 3 average runs: $VARIANCE_ACCEPTED%...";
 
 $1 > ____tempfile.data.polybench;
-$1 >> ____tempfile.data.polybench;
-$1 >> ____tempfile.data.polybench;
-$1 >> ____tempfile.data.polybench;
-$1 >> ____tempfile.data.polybench;
 
-compute_mean_exec_time "____tempfile.data.polybench" "$1";
+if grep -q "^\[PolyBench\] repeat:" ____tempfile.data.polybench; then
+    compute_repeat_exec_time "____tempfile.data.polybench";
+else
+    $1 >> ____tempfile.data.polybench;
+    $1 >> ____tempfile.data.polybench;
+    $1 >> ____tempfile.data.polybench;
+    $1 >> ____tempfile.data.polybench;
+    compute_mean_exec_time "____tempfile.data.polybench" "$1";
+fi;
+
 #echo "[INFO] Normalized time: $PROCESSED_TIME";
-echo "$(basename -- "$1")\t$variance\t$PROCESSED_TIME"
+reports=`collect_reports "____tempfile.data.polybench"`;
+if [ -z "$reports" ]; then
+    echo "$(basename -- "$1")\t$variance\t$PROCESSED_TIME"
+else
+    echo "$(basename -- "$1")\t$variance\t$PROCESSED_TIME\t$reports"
+fi;
 rm -f ____tempfile.data.polybench;
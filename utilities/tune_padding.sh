@@ -0,0 +1,110 @@
+#!/usr/bin/env bash
+
+# Padding autotuner.
+#
+# For each program of a source directory, times the kernel with several
+# intra-array (POLYBENCH_PADDING_FACTOR, in elements per dimension) and
+# inter-array (POLYBENCH_INTER_ARRAY_PADDING_FACTOR, in bytes) paddings,
+# and writes the fastest to
+# eval/padding/<src>_<compiler>_<opt>_<size>_<program>.conf, which
+# run.sh then applies when compiling that program (built with the same
+# compiler).
+#
+# The search is coordinate-wise: intra-array padding first, without
+# inter-array padding, then inter-array padding with the best intra-array
+# one. A padding is kept only if it beats the best time so far by more
+# than the threshold, so that noise does not select one.
+#
+# basic usage:
+# ./utilities/tune_padding.sh -d original -s LARGE -o O2
+
+
+# parse command line args
+while getopts c:o:d:s:p:e:b:t: flag
+do
+    case "${flag}" in
+        c) compiler=${OPTARG};;
+        o) opt_level=${OPTARG};;
+        d) directory=${OPTARG};;
+        s) size=${OPTARG};;
+        p) prog=${OPTARG};;
+        e) ci_target=${OPTARG};;
+        b) budget=${OPTARG};;
+        t) threshold=${OPTARG};;
+        *) ;;
+    esac
+done
+
+CC="${compiler:-gcc}"                       # compiler, default: gcc
+OPT="${opt_level:-O0}"                      # optimization level, default: O0
+SRC="${directory:-original}"                # source directory, default: original
+DS_SIZE=${size:-STANDARD}                   # dataset size
+PROGRAM=${prog}                             # tune only this program
+CI_TARGET="${ci_target:-2.0}"               # target half-width (%) of the median's 95% CI
+TIME_BUDGET="${budget:-5}"                  # max. sampling time per candidate (s)
+THRESHOLD="${threshold:-2}"                 # min. improvement (%) to keep a padding
+
+# candidate paddings, overridable from the environment
+INTRA=(${TUNE_PADDINGS:-0 1 2 4 8 16})
+INTER=(${TUNE_INTER_PADDINGS:-0 64 128 256 512 1024})
+
+CDIR="compiled"
+PAD_DIR="eval/padding"
+[ -d "$CDIR" ] || mkdir "$CDIR"
+[ -d "$PAD_DIR" ] || mkdir -p "$PAD_DIR"
+
+# median kernel time of program $1 with paddings $2 (intra) and $3 (inter)
+time_padding()
+{
+    local out=./"$CDIR"/"$1"_tune
+    local flags=(-DPOLYBENCH_PADDING_FACTOR="$2")
+    [[ $3 != "0" ]] && flags+=(-DPOLYBENCH_INTER_ARRAY_PADDING_FACTOR="$3")
+    "$CC" ./"$SRC"/"$1".c -"$OPT" -fopenmp -I utilities -I headers utilities/polybench.c \
+        -DPOLYBENCH_TIME -DPOLYBENCH_MONOTONIC_TIMER -DPOLYBENCH_REPEAT -D"$DS_SIZE"_DATASET \
+        "${flags[@]}" -lm -o "$out" || return 1
+    local result=($(POLYBENCH_CI_TARGET="$CI_TARGET" POLYBENCH_TIME_BUDGET="$TIME_BUDGET" \
+                    /bin/sh ./utilities/time_benchmark.sh "$out"))
+    rm -f "$out"
+    echo "${result[2]}"
+}
+
+# whether time $1 improves on $2 by more than the threshold
+faster()
+{
+    awk -v t="$1" -v best="$2" -v th="$THRESHOLD" 'BEGIN { exit !(t < best * (1 - th / 100)) }'
+}
+
+for file in ./"$SRC"/*.c
+do
+    filename=$(basename -- "$file")
+    filename="${filename%.*}"
+
+    if [ -n "$PROGRAM" ]; then
+        [[ "$PROGRAM" != "$filename" ]] && continue
+    fi
+
+    best_intra=0; best_inter=0
+    base=$(time_padding "$filename" 0 0) || continue
+    best=$base
+    for pad in "${INTRA[@]}"; do
+        [[ $pad == "0" ]] && continue
+        echo -ne "  ⧗ $filename - padding $pad, inter-array 0\033[0K\r"
+        t=$(time_padding "$filename" "$pad" 0) || continue
+        faster "$t" "$best" && { best=$t; best_intra=$pad; }
+    done
+    for pad in "${INTER[@]}"; do
+        [[ $pad == "0" ]] && continue
+        echo -ne "  ⧗ $filename - padding $best_intra, inter-array $pad\033[0K\r"
+        t=$(time_padding "$filename" "$best_intra" "$pad") || continue
+        faster "$t" "$best" && { best=$t; best_inter=$pad; }
+    done
+
+    conf=./"$PAD_DIR"/"$SRC"_"$(basename -- "$CC")"_"$OPT"_"$DS_SIZE"_"$filename".conf
+    {
+        echo "# $SRC/$filename, $DS_SIZE, -$OPT, $CC: $best s (unpadded: $base s)"
+        echo "PADDING_FACTOR=$best_intra"
+        echo "INTER_ARRAY_PADDING_FACTOR=$best_inter"
+    } > "$conf"
+
+    echo -e "\033[1;32m✓\033[0m ($(date '+%H:%M:%S')) tuned ("$DS_SIZE", -"$OPT", "$SRC"): ${filename} padding=$best_intra inter-array=$best_inter\033[0K"
+done